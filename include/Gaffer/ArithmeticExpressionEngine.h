@@ -0,0 +1,153 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2014, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFER_ARITHMETICEXPRESSIONENGINE_H
+#define GAFFER_ARITHMETICEXPRESSIONENGINE_H
+
+#include "IECore/InternedString.h"
+
+#include "Gaffer/Expression.h"
+
+namespace Gaffer
+{
+
+IE_CORE_FORWARDDECLARE( ArithmeticExpressionEngine )
+
+/// An Expression::Engine for simple numeric expressions, registered with
+/// the engine type "arithmetic". Expressions are written using the same
+/// syntax as for the python engine, but are limited to a single assignment
+/// of an arithmetic expression. They are compiled when the engine is created,
+/// and are executed without any involvement from python, so they may be
+/// evaluated concurrently on many threads.
+///
+/// The following are supported :
+///
+/// - Reading and writing numeric plugs as parent["node"]["plug"].
+/// - Reading numeric context variables as context["name"], context.get( "name" ),
+///   context.get( "name", default ) and context.getFrame().
+/// - Numeric literals, True and False.
+/// - The operators +, -, *, /, //, %, **, <, <=, >, >=, ==, !=, and, or and not,
+///   along with conditional expressions of the form "a if condition else b".
+/// - The functions abs(), min(), max(), pow(), round(), int(), float() and bool().
+///
+/// All arithmetic is performed in double precision floating point, and the
+/// result is converted to the type of the output plug when it is set. This
+/// differs from python in the following ways :
+///
+/// - The "/" operator always performs true division, even when both operands
+///   are integers, so 7 / 2 yields 3.5 and -7 / 2 yields -3.5 rather than
+///   3 and -4. Use "//" where python's integer division is wanted.
+/// - Integers are only exactly representable up to 2^53, and there is no
+///   arbitrary precision arithmetic.
+/// - Results outside the range of an IntPlug, including infinities and NaNs,
+///   raise an error rather than being converted. Float results are truncated
+///   towards zero when converted to an IntPlug.
+class ArithmeticExpressionEngine : public Expression::Engine
+{
+
+	public :
+
+		/// Throws if the expression is invalid.
+		ArithmeticExpressionEngine( const std::string &expression );
+		virtual ~ArithmeticExpressionEngine();
+
+		IE_CORE_DECLAREMEMBERPTR( ArithmeticExpressionEngine );
+
+		virtual std::string outPlug();
+		virtual void inPlugs( std::vector<std::string> &plugPaths );
+		virtual void contextNames( std::vector<std::string> &names );
+		virtual void execute( const Context *context, const std::vector<const ValuePlug *> &proxyInputs, ValuePlug *proxyOutput );
+
+	private :
+
+		enum OpCode
+		{
+			Constant,
+			Input,
+			ContextVariable,
+			ContextVariableWithDefault,
+			Negate,
+			Not,
+			Add,
+			Subtract,
+			Multiply,
+			Divide,
+			FloorDivide,
+			Modulo,
+			Power,
+			Less,
+			LessEqual,
+			Greater,
+			GreaterEqual,
+			Equal,
+			NotEqual,
+			Abs,
+			Min,
+			Max,
+			Round,
+			Int,
+			Bool,
+			Jump,
+			JumpIfFalse,
+			JumpIfFalseOrPop,
+			JumpIfTrueOrPop
+		};
+
+		// A single instruction for a simple stack machine. The
+		// meaning of value and index depends on the opcode.
+		struct Op
+		{
+			Op( OpCode code, double value = 0.0, size_t index = 0 );
+			OpCode code;
+			double value;
+			size_t index;
+		};
+
+		class Parser;
+
+		static EngineDescription<ArithmeticExpressionEngine> g_engineDescription;
+
+		std::string m_outPlug;
+		std::vector<std::string> m_inPlugs;
+		std::vector<IECore::InternedString> m_contextNames;
+		std::vector<Op> m_program;
+		size_t m_stackSize;
+
+};
+
+} // namespace Gaffer
+
+#endif // GAFFER_ARITHMETICEXPRESSIONENGINE_H
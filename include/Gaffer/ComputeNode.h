@@ -41,6 +41,7 @@
 #include "IECore/MurmurHash.h"
 
 #include "Gaffer/DependencyNode.h"
+#include "Gaffer/ValuePlug.h"
 
 namespace Gaffer
 {
@@ -73,10 +74,33 @@ class ComputeNode : public DependencyNode
 		/// In the special case that the node will pass through a value from an input plug
 		/// unchanged, the hash for the input plug should be assigned directly to the result
 		/// (rather than appended) - this allows cache entries to be shared.
+		///
+		/// Hashes are cached per context until the output plug is next dirtied, so
+		/// the hash must depend only on the context and on inputs which are declared
+		/// to affect the output via affects().
 		virtual void hash( const ValuePlug *output, const Context *context, IECore::MurmurHash &h ) const = 0;
 		/// Called to compute the values for output Plugs. Must be implemented to compute
 		/// an appropriate value and apply it using output->setValue().
 		virtual void compute( ValuePlug *output, const Context *context ) const = 0;
+		/// Called to determine whether or not concurrent requests for the same
+		/// output value should share a single computation. When true (the default),
+		/// the first thread to request a value performs the computation, and any
+		/// other threads requesting it in the meantime wait for the result rather
+		/// than computing it again. Nodes with very cheap computations may return
+		/// false to avoid the synchronisation overhead, in which case each thread
+		/// computes the value independently.
+		virtual bool shareComputations( const ValuePlug *output ) const;
+		/// Called to determine how the values computed for an output should be
+		/// cached. The default implementation returns ValuePlug::Cached. Nodes
+		/// which are cheap to compute relative to the memory their results use,
+		/// or which perform their own caching, may return ValuePlug::Uncached.
+		/// Note that the Plug::Cacheable flag takes precedence over this policy.
+		virtual ValuePlug::CachePolicy cachePolicy( const ValuePlug *output ) const;
+		/// Called for outputs with the ValuePlug::CachedIfExpensive policy, to
+		/// determine the minimum time in microseconds that a computation must
+		/// take for its value to be cached. The default implementation returns
+		/// ValuePlug::getCacheComputeTimeThreshold().
+		virtual size_t cacheComputeTimeThreshold( const ValuePlug *output ) const;
 		
 	private :
 			
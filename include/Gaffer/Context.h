@@ -75,10 +75,11 @@ class Context : public IECore::RefCounted
 			/// long as the Context needs it. Because the Context
 			/// doesn't have sole ownership of the value, other code
 			/// could change the value without its knowledge. It is the
-			/// responsibility of client code to either ensure that this does
-			/// not happen, or to manually emit changedSignal() as
-			/// necessary when it does. This avoids the overhead of copying
-			/// values when setting them.
+			/// responsibility of client code to ensure that this does
+			/// not happen - values must never be modified in place, as
+			/// the Context would neither update its hash() nor emit
+			/// changedSignal(). To change a value, set() a new one instead.
+			/// This avoids the overhead of copying values when setting them.
 			Shared,
 			/// The Context simply references an existing value, and doesn't
 			/// even increment its reference count. In addition to the constraints
@@ -132,6 +133,10 @@ class Context : public IECore::RefCounted
 		/// A signal emitted when an element of the context is changed.
 		ChangedSignal &changedSignal();
 		
+		/// Returns a hash of all the entries in the context. The hash
+		/// is maintained incrementally as entries are set, so this is a
+		/// constant time operation. It follows that values must not be
+		/// modified in place after being set (see Ownership).
 		IECore::MurmurHash hash() const;
 		
 		bool operator == ( const Context &other ) const;
@@ -163,11 +168,58 @@ class Context : public IECore::RefCounted
 		
 		};
 		
+		/// The EditableScope class provides an efficient means of creating a
+		/// temporary modified version of a context and making it current on
+		/// the calling thread. It should be preferred over constructing a new
+		/// Context with Borrowed ownership in the performance critical parts of
+		/// compute() methods, because rather than copying all the entries of the
+		/// original, it simply layers the modified entries on top of them. The
+		/// layered contexts are also recycled between scopes, so in the common
+		/// case no allocations are made at all. The same constraints apply as for
+		/// Borrowed ownership - the original context must remain alive and unchanged
+		/// for the lifetime of the scope.
+		class EditableScope : boost::noncopyable
+		{
+		
+			public :
+			
+				/// Pushes a context layered on top of the specified one.
+				EditableScope( const Context *context );
+				/// Pops the context, and recycles it for use by subsequent scopes.
+				~EditableScope();
+				
+				/// Sets a value in the layered context, without affecting the
+				/// original.
+				template<typename T>
+				void set( const IECore::InternedString &name, const T &value );
+				void setFrame( float frame );
+				
+				/// Returns the layered context, which is current for the
+				/// lifetime of the scope.
+				const Context *context() const;
+			
+			private :
+			
+				Ptr m_context;
+			
+		};
+		
 		/// Returns the current context for the calling thread.
 		static const Context *current();
 		
 	private :
 
+		// Constructs an empty context layered on top of parent, for
+		// use by EditableScope. Entries not found in the layer are
+		// retrieved from the parent.
+		Context( const Context *parent );
+		
+		// Makes this a layer on top of parent, reusing the storage
+		// of a previous layer.
+		void setParent( const Context *parent );
+		// Removes all our entries and detaches us from our parent.
+		void clear();
+		
 		void substituteInternal( const std::string &s, std::string &result, const int recursionDepth ) const;
 	
 		// Storage for each entry.
@@ -180,12 +232,66 @@ class Context : public IECore::RefCounted
 			// And use this ownership flag to tell us when we need to do explicit
 			// reference count management.
 			Ownership ownership;
+			// The hash of the name and value, computed when the value is set.
+			// This allows us to update the hash of the whole context incrementally.
+			IECore::MurmurHash hash;
 		};
 	
 		typedef boost::container::flat_map<IECore::InternedString, Storage> Map;
 		
+		// Returns the value for the named entry, taking into account
+		// our parent if we have one, or NULL if there is no such entry.
+		inline const IECore::Data *lookup( const IECore::InternedString &name ) const;
+		// Calls f( name, storage ) for each entry, in the same order as
+		// it would be visited in an equivalent context with no parent.
+		template<typename F>
+		void visitEntries( F &f ) const;
+		
+		// Computes the hash for an entry.
+		static inline IECore::MurmurHash entryHash( const IECore::InternedString &name, const IECore::Data *value );
+		// The hash of the context is the sum of the hashes of all its entries, which
+		// allows it to be updated in constant time as entries are added and removed.
+		inline void addEntryHash( const IECore::MurmurHash &h );
+		inline void removeEntryHash( const IECore::MurmurHash &h );
+		
 		Map m_map;
 		ChangedSignal *m_changedSignal;
+		// When non-NULL, we are a layer created by an EditableScope, and
+		// m_map holds only the entries which override those of the parent.
+		// The parent is guaranteed not to be a layer itself, so that
+		// lookups never need to traverse more than one level.
+		const Context *m_parent;
+		// The sum of the hashes of all our entries, including those
+		// inherited from our parent.
+		IECore::MurmurHash m_hash;
+		
+		// The handful of variables used by almost every compute are given
+		// fast slots, so that they can be retrieved without searching the
+		// map, and set without allocating new values. The map remains the
+		// definitive storage for every entry, and is used for everything
+		// other than get() and set().
+		enum FastSlot
+		{
+			FrameSlot,
+			ChannelNameSlot,
+			TileOriginSlot,
+			ScenePathSlot,
+			NumFastSlots
+		};
+		
+		static const IECore::InternedString g_fastSlotNames[NumFastSlots];
+		// Returns the slot for the named entry, or -1 if it doesn't have one.
+		static inline int fastSlot( const IECore::InternedString &name );
+		
+		// Pointers to the current values of the slotted entries, or NULL
+		// for entries which haven't been set.
+		const IECore::Data *m_fastValues[NumFastSlots];
+		// Values owned by the context, which are updated in place when the
+		// slotted entries are set, as long as no-one else references them.
+		// Because the layers used by EditableScopes are recycled, this means
+		// that setting tile origins and scene paths in a scope typically
+		// makes no allocations at all.
+		IECore::DataPtr m_fastStorage[NumFastSlots];
 
 };
 
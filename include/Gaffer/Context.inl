@@ -86,6 +86,43 @@ struct Context::Accessor
 		return true;
 	}
 	
+	/// As for set(), but attempts to reuse the value stored in reusable
+	/// rather than allocate a new one.
+	bool setFast( Storage &storage, IECore::DataPtr &reusable, const T &value )
+	{
+		const IECore::TypedData<T> *d = IECore::runTimeCast<const IECore::TypedData<T> >( storage.data );
+		if( d && d->readable() == value )
+		{
+			return false;
+		}
+		
+		IECore::TypedData<T> *r = IECore::runTimeCast<IECore::TypedData<T> >( reusable.get() );
+		if( r && r->refCount() == 1 )
+		{
+			// no-one but us has a reference to the value, so we can
+			// modify it in place.
+			r->writable() = value;
+		}
+		else
+		{
+			r = new IECore::TypedData<T>( value );
+			reusable = r;
+		}
+		
+		if( storage.data != r )
+		{
+			if( storage.data && storage.ownership != Borrowed )
+			{
+				storage.data->removeRef();
+			}
+			// reusable holds the reference for us.
+			storage.data = r;
+			storage.ownership = Borrowed;
+		}
+		
+		return true;
+	}
+	
 	ResultType get( const IECore::Data *data )
 	{
 		if( !data->isInstanceOf( IECore::TypedData<T>::staticTypeId() ) )
@@ -123,6 +160,13 @@ struct Context::Accessor<T, typename boost::enable_if<boost::is_base_of<IECore::
 		return true;
 	}
 	
+	bool setFast( Storage &storage, IECore::DataPtr &reusable, const T &value )
+	{
+		// we're obliged to take a copy anyway, so there's nothing
+		// to be gained from reuse.
+		return set( storage, value );
+	}
+	
 	ResultType get( const IECore::Data *data )
 	{
 		if( !data->isInstanceOf( T::staticTypeId() ) )
@@ -136,9 +180,39 @@ struct Context::Accessor<T, typename boost::enable_if<boost::is_base_of<IECore::
 template<typename T>
 void Context::set( const IECore::InternedString &name, const T &value )
 {
-	Storage &s = m_map[name];
-	if( Accessor<T>().set( s, value ) )
+	Map::iterator it = m_map.find( name );
+	if( it == m_map.end() )
+	{
+		it = m_map.insert( Map::value_type( name, Storage() ) ).first;
+		if( m_parent )
+		{
+			Map::const_iterator pIt = m_parent->m_map.find( name );
+			if( pIt != m_parent->m_map.end() )
+			{
+				// we're overriding an entry from our parent
+				removeEntryHash( pIt->second.hash );
+			}
+		}
+	}
+	
+	Storage &s = it->second;
+	const bool hadValue = s.data;
+	const IECore::MurmurHash previousHash = s.hash;
+	const int slot = fastSlot( name );
+	if( slot >= 0 ? Accessor<T>().setFast( s, m_fastStorage[slot], value ) : Accessor<T>().set( s, value ) )
 	{
+		if( hadValue )
+		{
+			removeEntryHash( previousHash );
+		}
+		s.hash = entryHash( name, s.data );
+		addEntryHash( s.hash );
+		
+		if( slot >= 0 )
+		{
+			m_fastValues[slot] = s.data;
+		}
+		
 		if( m_changedSignal )
 		{
 			(*m_changedSignal)( this, name );		
@@ -149,23 +223,90 @@ void Context::set( const IECore::InternedString &name, const T &value )
 template<typename T>
 typename Context::Accessor<T>::ResultType Context::get( const IECore::InternedString &name ) const
 {
-	Map::const_iterator it = m_map.find( name );
-	if( it == m_map.end() )
+	const IECore::Data *d = lookup( name );
+	if( !d )
 	{
 		throw IECore::Exception( boost::str( boost::format( "Context has no entry named \"%s\"" ) % name.value() ) );
 	}
-	return Accessor<T>().get( it->second.data );
+	return Accessor<T>().get( d );
 }
 
 template<typename T>
 typename Context::Accessor<T>::ResultType Context::get( const IECore::InternedString &name, typename Accessor<T>::ResultType defaultValue ) const
 {
-	Map::const_iterator it = m_map.find( name );
-	if( it == m_map.end() )
+	const IECore::Data *d = lookup( name );
+	if( !d )
 	{
 		return defaultValue;
 	}
-	return Accessor<T>().get( it->second.data );
+	return Accessor<T>().get( d );
+}
+
+inline const IECore::Data *Context::lookup( const IECore::InternedString &name ) const
+{
+	const int slot = fastSlot( name );
+	if( slot >= 0 && m_fastValues[slot] )
+	{
+		return m_fastValues[slot];
+	}
+	
+	Map::const_iterator it = m_map.find( name );
+	if( it != m_map.end() )
+	{
+		return it->second.data;
+	}
+	
+	if( m_parent )
+	{
+		it = m_parent->m_map.find( name );
+		if( it != m_parent->m_map.end() )
+		{
+			return it->second.data;
+		}
+	}
+	
+	return NULL;
+}
+
+inline int Context::fastSlot( const IECore::InternedString &name )
+{
+	for( int i = 0; i < NumFastSlots; ++i )
+	{
+		if( name == g_fastSlotNames[i] )
+		{
+			return i;
+		}
+	}
+	return -1;
+}
+
+IECore::MurmurHash Context::entryHash( const IECore::InternedString &name, const IECore::Data *value )
+{
+	IECore::MurmurHash result;
+	result.append( name );
+	value->hash( result );
+	return result;
+}
+
+void Context::addEntryHash( const IECore::MurmurHash &h )
+{
+	m_hash = IECore::MurmurHash( m_hash.h1() + h.h1(), m_hash.h2() + h.h2() );
+}
+
+void Context::removeEntryHash( const IECore::MurmurHash &h )
+{
+	m_hash = IECore::MurmurHash( m_hash.h1() - h.h1(), m_hash.h2() - h.h2() );
+}
+
+template<typename T>
+void Context::EditableScope::set( const IECore::InternedString &name, const T &value )
+{
+	m_context->set( name, value );
+}
+
+inline const Context *Context::EditableScope::context() const
+{
+	return m_context.get();
 }
 		
 } // namespace Gaffer
@@ -73,6 +73,10 @@ class ContextProcessor : public BaseType
 		/// and should only implement processContext().
 		virtual void hash( const ValuePlug *output, const Context *context, IECore::MurmurHash &h ) const;
 		virtual void compute( ValuePlug *output, const Context *context ) const;
+		/// Implemented to return false for outputs which pass through an input
+		/// value. These share their hash with the upstream computation, which will
+		/// be shared anyway, so there is no benefit in sharing them again.
+		virtual bool shareComputations( const ValuePlug *output ) const;
 		
 		/// Should be called by derived class affects() methods when the input
 		/// affects their implementation of processContext().
@@ -195,6 +195,16 @@ void ContextProcessor<BaseType>::compute( ValuePlug *output, const Context *cont
 	return BaseType::compute( output, context );
 }
 
+template<typename BaseType>
+bool ContextProcessor<BaseType>::shareComputations( const ValuePlug *output ) const
+{
+	if( oppositePlug( output ) )
+	{
+		return false;
+	}
+	return BaseType::shareComputations( output );
+}
+
 template<typename BaseType>
 const ValuePlug *ContextProcessor<BaseType>::oppositePlug( const ValuePlug *plug ) const
 {
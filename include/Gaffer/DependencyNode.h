@@ -38,6 +38,9 @@
 #ifndef GAFFER_DEPENDENCYNODE_H
 #define GAFFER_DEPENDENCYNODE_H
 
+#include "boost/unordered_map.hpp"
+#include "boost/unordered_set.hpp"
+
 #include "Gaffer/Node.h"
 
 namespace Gaffer
@@ -66,6 +69,11 @@ class DependencyNode : public Node
 		/// for input or to place one in outputs as computations are always performed on the
 		/// leaf level plugs only. Implementations of this method should call the base class
 		/// implementation first.
+		///
+		/// The results are cached for use in dirty propagation, and the cache is only
+		/// invalidated when plugs are added, removed or connected, or when a plug on
+		/// the node itself is edited. Implementations must therefore not depend on the
+		/// values of plugs on other nodes, or on computed values.
 		virtual void affects( const Plug *input, AffectedPlugsContainer &outputs ) const = 0;
 		
 		/// @name Enable/Disable Behaviour
@@ -89,8 +97,26 @@ class DependencyNode : public Node
 	
 		friend class Plug;
 		friend class ValuePlug;
+		friend class DirtyPropagationScope;
 		
 		static void propagateDirtiness( Plug *plugToDirty );
+		static void pushDirtyPropagationScope();
+		static void popDirtyPropagationScope();
+		static void emitDirtiness();
+		
+		typedef boost::unordered_set<Plug *> VisitedPlugs;
+		static void visitDirtiness( Plug *plug, VisitedPlugs &visited, std::vector<Plug *> &order );
+
+		// Returns the cached result of affects(), computing
+		// it first if necessary.
+		const AffectedPlugsContainer &affectsTable( const Plug *input ) const;
+		// Called by Plug when the structure of the graph changes,
+		// to invalidate the tables of all nodes.
+		static void invalidateAffectsTables();
+		
+		typedef boost::unordered_map<const Plug *, AffectedPlugsContainer> AffectsTable;
+		mutable AffectsTable m_affectsTable;
+		mutable size_t m_affectsTableVersion;
 
 };
 
@@ -56,6 +56,7 @@ namespace Gaffer
 
 IE_CORE_FORWARDDECLARE( Dispatcher )
 IE_CORE_FORWARDDECLARE( CompoundPlug )
+IE_CORE_FORWARDDECLARE( ExecutionLedger )
 
 /// Abstract base class which defines an interface for scheduling the execution
 /// of Context specific Tasks from ExecutableNodes which exist within a ScriptNode.
@@ -117,6 +118,12 @@ class Dispatcher : public Node
 		const StringPlug *jobDirectoryPlug() const;
 		/// Returns the directory specified by jobDirectoryPlug + jobNamePlug, creating it when necessary.
 		const std::string jobDirectory( const Context *context ) const;
+		/// Returns the plug which specifies the file used to store an ExecutionLedger. When this
+		/// is non-empty, dispatch() omits the Tasks which the ledger shows to have been executed
+		/// already, unless they require Tasks which are being executed. Derived classes are
+		/// responsible for recording the Tasks they execute successfully in the ledger.
+		StringPlug *executionLedgerPlug();
+		const StringPlug *executionLedgerPlug() const;
 		//@}
 		
 		//! @name Registration
@@ -180,6 +187,8 @@ class Dispatcher : public Node
 		// For all other nodes, Tasks will be grouped by executionHash, and the requirements will be
 		// a union of the requirements from all equivalent Tasks.
 		static void uniqueTasks( const ExecutableNode::Tasks &tasks, TaskDescriptions &uniqueTasks );
+		// Removes the Tasks which have already been executed according to the ledger.
+		static void removeExecutedTasks( const ExecutionLedger *ledger, TaskDescriptions &taskDescriptions );
 		static const ExecutableNode::Task &uniqueTask( const ExecutableNode::Task &task, TaskDescriptions &uniqueTasks, TaskSet &seenTasks );
 		
 		static size_t g_firstPlugIndex;
@@ -110,6 +110,20 @@ class ExecutableNode : public Node
 		/// don't cause side effects for the given context by returning a default hash.
 		virtual IECore::MurmurHash executionHash( const Context *context ) const = 0;
 		
+		/// Fills fileNames with the files created by calling execute with the given
+		/// context. These are used by the ExecutionLedger to determine whether or not
+		/// the results of a previous execution are still intact. The default
+		/// implementation declares no files.
+		virtual void executionOutputs( const Context *context, std::vector<std::string> &fileNames ) const;
+		
+		/// Returns true if executionHash() accounts for everything which affects the
+		/// results of execute(), so that two executions with the same hash are known
+		/// to produce identical outputs. The ExecutionLedger ignores nodes which return
+		/// false, as it can't tell whether or not their outputs are up to date. The
+		/// default implementation returns false, so that nodes must opt in to being
+		/// skipped by the ledger once they are known to hash everything they use.
+		virtual bool executionHashIsComplete() const;
+		
 		/// Executes this node for all the specified contexts in sequence.
 		virtual void execute( const Contexts &contexts ) const = 0;
 		
@@ -0,0 +1,109 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2014, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFER_EXECUTIONLEDGER_H
+#define GAFFER_EXECUTIONLEDGER_H
+
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "tbb/mutex.h"
+
+#include "IECore/RefCounted.h"
+
+#include "Gaffer/ExecutableNode.h"
+
+namespace Gaffer
+{
+
+IE_CORE_FORWARDDECLARE( ExecutionLedger )
+
+/// A persistent record of the Tasks which have been executed successfully,
+/// keyed by their execution hash. Dispatchers use the ledger to skip Tasks
+/// which would have no effect because their results already exist. A Task
+/// is considered to have been executed if its hash has been recorded, and
+/// all the files reported by ExecutableNode::executionOutputs() have been
+/// left unmodified since the record was made.
+///
+/// The ledger is stored as a text file with one record appended per line,
+/// so that several processes may safely share the same file.
+class ExecutionLedger : public IECore::RefCounted
+{
+
+	public :
+
+		/// Loads the existing records from fileName, if it exists.
+		ExecutionLedger( const std::string &fileName );
+		virtual ~ExecutionLedger();
+
+		IE_CORE_DECLAREMEMBERPTR( ExecutionLedger )
+
+		const std::string &fileName() const;
+
+		/// Returns true if the task has previously been recorded, and its outputs
+		/// are unchanged. Always returns false for Tasks with a default hash, and
+		/// for Tasks whose node doesn't have a complete execution hash.
+		bool executed( const ExecutableNode::Task &task ) const;
+		/// Records the successful execution of the task, appending the record
+		/// to the file immediately. Does nothing for Tasks which executed() would
+		/// always return false for. May be called concurrently from multiple
+		/// threads.
+		void record( const ExecutableNode::Task &task );
+
+	private :
+
+		struct Output
+		{
+			std::string fileName;
+			std::time_t modificationTime;
+		};
+
+		typedef std::vector<Output> Outputs;
+		typedef std::map<std::string, Outputs> Records;
+
+		static void outputs( const ExecutableNode::Task &task, Outputs &outputs );
+
+		std::string m_fileName;
+		Records m_records;
+		tbb::mutex m_mutex;
+
+};
+
+} // namespace Gaffer
+
+#endif // GAFFER_EXECUTIONLEDGER_H
@@ -90,6 +90,17 @@ class Expression : public ComputeNode
 				static void registerEngine( const std::string engineType, Creator creator );
 				static void registeredEngines( std::vector<std::string> &engineTypes );
 
+				/// Create a static instance of this to automatically register a derived class
+				/// with the factory mechanism. Derived class must have a constructor of the form
+				/// Derived( const std::string &expression ).
+				template<typename EngineType>
+				struct EngineDescription
+				{
+						EngineDescription( const std::string &engineType ) { registerEngine( engineType, &creator ); };
+					private :
+						static EnginePtr creator( const std::string &expression ) { return new EngineType( expression ); };
+				};
+
 			private :
 			
 				typedef std::map<std::string, Creator> CreatorMap;
@@ -110,8 +121,14 @@ class Expression : public ComputeNode
 		void parentChanged( GraphComponent *child, GraphComponent *oldParent );
 		
 		void updatePlugs( const std::string &outPlugPath, std::vector<std::string> &inPlugPaths );
+		// Sets m_engine and updates m_contextNames to match.
+		void setEngine( EnginePtr engine );
 		
 		EnginePtr m_engine;
+		// The result of m_engine->contextNames(), stored so that hash()
+		// doesn't need to query the engine, which for python engines
+		// would mean acquiring the GIL.
+		std::vector<IECore::InternedString> m_contextNames;
 		
 };
 
@@ -39,6 +39,7 @@
 #define GAFFER_GRAPHCOMPONENT_H
 
 #include "boost/signals.hpp"
+#include "boost/scoped_ptr.hpp"
 
 #include "IECore/RunTimeTyped.h"
 #include "IECore/InternedString.h"
@@ -246,6 +247,10 @@ class GraphComponent : public IECore::RunTimeTyped, public boost::signals::track
 		void setNameInternal( const IECore::InternedString &name );
 		void addChildInternal( GraphComponentPtr child );
 		void removeChildInternal( GraphComponentPtr child, bool emitParentChanged );
+		/// Returns the child with the specified name, or 0 if no such child exists.
+		const GraphComponent *childInternal( const IECore::InternedString &name ) const;
+		/// Returns a name for child which is unique among its siblings.
+		IECore::InternedString uniqueChildName( const GraphComponent *child, const IECore::InternedString &name ) const;
 
 		/// \todo The memory overhead of all these signals may become too great.
 		/// At this point we need to reimplement the signal returning functions to
@@ -261,6 +266,12 @@ class GraphComponent : public IECore::RunTimeTyped, public boost::signals::track
 		IECore::InternedString m_name;
 		GraphComponent *m_parent;
 		ChildContainer m_children;
+		
+		/// Lookups by name are linear in the number of children, which is
+		/// fine for the majority of components. For components with many
+		/// children we maintain an index to make naming and lookups fast.
+		struct ChildIndex;
+		boost::scoped_ptr<ChildIndex> m_childIndex;
 
 };
 
@@ -0,0 +1,82 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2014, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFER_INPROCESSDISPATCHER_H
+#define GAFFER_INPROCESSDISPATCHER_H
+
+#include "Gaffer/Dispatcher.h"
+
+namespace Gaffer
+{
+
+IE_CORE_FORWARDDECLARE( InProcessDispatcher )
+
+/// A Dispatcher which executes Tasks within the current process, avoiding the
+/// cost of launching a new process and loading the script for each Task. This
+/// makes it well suited to lightweight Tasks, which also benefit from sharing
+/// the ValuePlug cache. Independent Tasks are executed concurrently on a TBB
+/// flow graph, with the Tasks for each node grouped into batches executed by
+/// a single call to ExecutableNode::execute(). If a Task throws, only the Tasks
+/// which depend on it are skipped, and an exception summarising the failures
+/// is thrown once all other Tasks have been executed.
+class InProcessDispatcher : public Dispatcher
+{
+	public :
+
+		InProcessDispatcher( const std::string &name=defaultName<InProcessDispatcher>() );
+		virtual ~InProcessDispatcher();
+
+		IE_CORE_DECLARERUNTIMETYPEDEXTENSION( Gaffer::InProcessDispatcher, InProcessDispatcherTypeId, Dispatcher );
+
+		/// The maximum number of Tasks to be passed to each call to ExecutableNode::execute().
+		/// A value of 0 divides the Tasks for each node evenly between the available threads.
+		IntPlug *framesPerBatchPlug();
+		const IntPlug *framesPerBatchPlug() const;
+
+	protected :
+
+		virtual void doDispatch( const TaskDescriptions &taskDescriptions ) const;
+		virtual void doSetupPlugs( CompoundPlug *parentPlug ) const;
+
+	private :
+
+		static size_t g_firstPlugIndex;
+
+};
+
+} // namespace Gaffer
+
+#endif // GAFFER_INPROCESSDISPATCHER_H
@@ -0,0 +1,212 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2014, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFER_PERFORMANCEMONITOR_H
+#define GAFFER_PERFORMANCEMONITOR_H
+
+#include <map>
+#include <vector>
+#include <iostream>
+
+#include "boost/noncopyable.hpp"
+#include "boost/unordered_map.hpp"
+
+#include "tbb/atomic.h"
+#include "tbb/tick_count.h"
+#include "tbb/enumerable_thread_specific.h"
+
+#include "IECore/RefCounted.h"
+
+#include "Gaffer/ValuePlug.h"
+
+namespace Gaffer
+{
+
+IE_CORE_FORWARDDECLARE( PerformanceMonitor )
+
+/// The PerformanceMonitor class records statistics about the hashes and
+/// computations performed by ValuePlugs, so that the expensive parts of a
+/// graph can be identified. Monitoring is enabled using the nested Scope
+/// class, and while a scope is active it applies to computations performed
+/// on all threads. When no monitor is active the overhead is negligible.
+class PerformanceMonitor : public IECore::RefCounted
+{
+
+	public :
+
+		/// When recordEvents is true, the timing of every individual
+		/// computation is recorded in addition to the statistics, so that
+		/// a timeline can be output with writeChromeTrace(). This uses
+		/// memory in proportion to the number of computations performed.
+		PerformanceMonitor( bool recordEvents = false );
+		virtual ~PerformanceMonitor();
+
+		IE_CORE_DECLAREMEMBERPTR( PerformanceMonitor )
+
+		struct Statistics
+		{
+		
+			Statistics();
+			
+			/// The number of times ComputeNode::hash() was called.
+			size_t hashCount;
+			/// The number of times ComputeNode::compute() was called.
+			size_t computeCount;
+			/// The number of times the value was retrieved from
+			/// the cache instead of being computed.
+			size_t cacheHitCount;
+			/// The wall time in seconds spent in ComputeNode::compute(),
+			/// including the time spent computing upstream values.
+			double totalComputeTime;
+			/// As above, but excluding the time spent computing
+			/// upstream values on the same thread.
+			double exclusiveComputeTime;
+			
+			Statistics &operator += ( const Statistics &rhs );
+			bool operator == ( const Statistics &rhs ) const;
+			bool operator != ( const Statistics &rhs ) const;
+			
+		};
+		
+		typedef std::map<ConstValuePlugPtr, Statistics> StatisticsMap;
+
+		/// Returns the statistics recorded for each plug. Results are
+		/// only valid once all monitored computations have completed,
+		/// so this should not be called while the monitor is active.
+		StatisticsMap allStatistics() const;
+		/// Returns the statistics for a single plug.
+		Statistics plugStatistics( const ValuePlug *plug ) const;
+		/// Returns the statistics for all plugs combined.
+		Statistics combinedStatistics() const;
+
+		/// Writes the recorded computations in the JSON Trace Event Format,
+		/// suitable for viewing in Chrome's about:tracing page. Nothing is
+		/// written for monitors constructed without recordEvents.
+		void writeChromeTrace( std::ostream &stream ) const;
+		
+		/// The Scope class is used to activate a monitor. Only one monitor
+		/// is active at a time - that of the most recently constructed scope
+		/// which is still alive. Scopes may be destroyed in any order, and the
+		/// active monitor is kept alive for as long as it is being used.
+		class Scope : boost::noncopyable
+		{
+		
+			public :
+			
+				Scope( PerformanceMonitorPtr monitor );
+				~Scope();
+			
+			private :
+			
+				PerformanceMonitorPtr m_monitor;
+		
+		};
+
+		//! @name Recording
+		/// These methods are used by ValuePlug to report its activity to
+		/// the active monitor, and do nothing if there isn't one. They don't
+		/// need to be called by other code.
+		////////////////////////////////////////////////////////
+		//@{
+		static inline void recordHash( const ValuePlug *plug );
+		static inline void recordCacheHit( const ValuePlug *plug );
+		/// Records the duration of a call to ComputeNode::compute().
+		class ComputeScope : boost::noncopyable
+		{
+		
+			public :
+			
+				inline ComputeScope( const ValuePlug *plug );
+				inline ~ComputeScope();
+				
+			private :
+			
+				PerformanceMonitorPtr m_monitor;
+				const ValuePlug *m_plug;
+				tbb::tick_count m_startTime;
+			
+		};
+		//@}
+
+	private :
+
+		void hashed( const ValuePlug *plug );
+		void cacheHit( const ValuePlug *plug );
+		void computeStarted();
+		void computeFinished( const ValuePlug *plug, const tbb::tick_count &startTime );
+
+		struct Event
+		{
+			ConstValuePlugPtr plug;
+			double startTime;
+			double duration;
+		};
+		
+		// Each thread records into its own data, so that
+		// threads don't contend for access.
+		struct ThreadData
+		{
+			ThreadData();
+			
+			typedef boost::unordered_map<const ValuePlug *, std::pair<ConstValuePlugPtr, Statistics> > PlugStatistics;
+			PlugStatistics statistics;
+			// Stack of the accumulated upstream compute times for the
+			// computations in progress, used to derive exclusive times.
+			std::vector<double> upstreamComputeTimes;
+			std::vector<Event> events;
+			size_t id;
+		};
+		
+		Statistics &statistics( ThreadData &threadData, const ValuePlug *plug );
+		
+		bool m_recordEvents;
+		tbb::tick_count m_startTime;
+		typedef tbb::enumerable_thread_specific<ThreadData> ThreadSpecificData;
+		ThreadSpecificData m_threadData;
+		
+		// Returns the active monitor, or NULL if there isn't one.
+		static PerformanceMonitorPtr activeMonitor();
+		// The number of active scopes. Used to avoid the cost of
+		// calling activeMonitor() when monitoring is not in use.
+		static tbb::atomic<size_t> g_activeScopes;
+		
+};
+
+} // namespace Gaffer
+
+#include "Gaffer/PerformanceMonitor.inl"
+
+#endif // GAFFER_PERFORMANCEMONITOR_H
@@ -0,0 +1,87 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2014, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFER_PERFORMANCEMONITOR_INL
+#define GAFFER_PERFORMANCEMONITOR_INL
+
+namespace Gaffer
+{
+
+inline void PerformanceMonitor::recordHash( const ValuePlug *plug )
+{
+	if( !g_activeScopes )
+	{
+		return;
+	}
+	if( PerformanceMonitorPtr m = activeMonitor() )
+	{
+		m->hashed( plug );
+	}
+}
+
+inline void PerformanceMonitor::recordCacheHit( const ValuePlug *plug )
+{
+	if( !g_activeScopes )
+	{
+		return;
+	}
+	if( PerformanceMonitorPtr m = activeMonitor() )
+	{
+		m->cacheHit( plug );
+	}
+}
+
+inline PerformanceMonitor::ComputeScope::ComputeScope( const ValuePlug *plug )
+	:	m_monitor( g_activeScopes ? activeMonitor() : PerformanceMonitorPtr() ), m_plug( plug )
+{
+	if( m_monitor )
+	{
+		m_monitor->computeStarted();
+		m_startTime = tbb::tick_count::now();
+	}
+}
+
+inline PerformanceMonitor::ComputeScope::~ComputeScope()
+{
+	if( m_monitor )
+	{
+		m_monitor->computeFinished( m_plug, m_startTime );
+	}
+}
+
+} // namespace Gaffer
+
+#endif // GAFFER_PERFORMANCEMONITOR_INL
@@ -82,7 +82,8 @@ class Plug : public GraphComponent
 			PerformsSubstitutions = 0x00000008,
 			/// If the Cacheable flag is set then values computed during getValue()
 			/// calls will be stored in a cache and reused if equivalent computations
-			/// are requested in the future.
+			/// are requested in the future. See also ComputeNode::cachePolicy(),
+			/// which provides finer control over caching.
 			Cacheable = 0x00000010,
 			/// Read only plugs do not accept any changes to their inputs, and will throw
 			/// an exception if an attempt is made to call their setValue() method. It is
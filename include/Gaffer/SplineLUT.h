@@ -0,0 +1,89 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2014, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFER_SPLINELUT_H
+#define GAFFER_SPLINELUT_H
+
+#include <vector>
+#include <algorithm>
+
+#include "IECore/Spline.h"
+
+namespace Gaffer
+{
+
+/// A baked representation of an IECore::Spline, allowing it to be evaluated
+/// much more quickly than by calling Spline::operator() directly, which must
+/// search the control points and solve for the curve parameter for each sample.
+/// The spline is sampled uniformly across the range of its control points, and
+/// evaluation interpolates linearly between the samples, clamping outside of the
+/// range. The result is therefore an approximation, whose accuracy is determined
+/// by the resolution.
+template<typename T>
+class SplineLUT
+{
+
+	public :
+
+		typedef T SplineType;
+		typedef typename T::XType XType;
+		typedef typename T::YType YType;
+
+		SplineLUT( const T &spline, size_t resolution = 1024 );
+
+		/// Returns the value of the spline at x.
+		inline YType operator()( XType x ) const;
+		/// Evaluates the spline for n samples at once, placing the
+		/// results in result.
+		void evaluate( const XType *x, YType *result, size_t n ) const;
+
+	private :
+
+		XType m_min;
+		XType m_scale;
+		XType m_maxIndex;
+		std::vector<YType> m_values;
+
+};
+
+typedef SplineLUT<IECore::Splineff> SplineffLUT;
+typedef SplineLUT<IECore::SplinefColor3f> SplinefColor3fLUT;
+
+} // namespace Gaffer
+
+#include "Gaffer/SplineLUT.inl"
+
+#endif // GAFFER_SPLINELUT_H
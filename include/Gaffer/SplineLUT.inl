@@ -0,0 +1,106 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2014, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFER_SPLINELUT_INL
+#define GAFFER_SPLINELUT_INL
+
+namespace Gaffer
+{
+
+template<typename T>
+SplineLUT<T>::SplineLUT( const T &spline, size_t resolution )
+	:	m_min( 0 ), m_scale( 0 ), m_maxIndex( 0 )
+{
+	if( spline.points.empty() )
+	{
+		m_values.push_back( YType( 0 ) );
+		return;
+	}
+
+	resolution = std::max( resolution, (size_t)2 );
+
+	m_min = spline.points.begin()->first;
+	const XType max = spline.points.rbegin()->first;
+	const XType range = max - m_min;
+	if( range <= XType( 0 ) )
+	{
+		m_values.push_back( spline( m_min ) );
+		return;
+	}
+
+	m_maxIndex = resolution - 1;
+	m_scale = m_maxIndex / range;
+
+	m_values.reserve( resolution );
+	for( size_t i = 0; i < resolution; ++i )
+	{
+		m_values.push_back( spline( m_min + range * XType( i ) / m_maxIndex ) );
+	}
+}
+
+template<typename T>
+inline typename SplineLUT<T>::YType SplineLUT<T>::operator()( XType x ) const
+{
+	const XType f = ( x - m_min ) * m_scale;
+	// written to also catch NaNs
+	if( !( f > XType( 0 ) ) )
+	{
+		return m_values.front();
+	}
+	if( f >= m_maxIndex )
+	{
+		return m_values.back();
+	}
+
+	const size_t i = static_cast<size_t>( f );
+	const XType t = f - XType( i );
+	const YType &y0 = m_values[i];
+	const YType &y1 = m_values[i+1];
+	return y0 + ( y1 - y0 ) * t;
+}
+
+template<typename T>
+void SplineLUT<T>::evaluate( const XType *x, YType *result, size_t n ) const
+{
+	for( const XType *e = x + n; x != e; ++x, ++result )
+	{
+		*result = (*this)( *x );
+	}
+}
+
+} // namespace Gaffer
+
+#endif // GAFFER_SPLINELUT_INL
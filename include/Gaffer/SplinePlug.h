@@ -38,12 +38,17 @@
 #ifndef GAFFER_SPLINEPLUG_H
 #define GAFFER_SPLINEPLUG_H
 
+#include "tbb/spin_mutex.h"
+
+#include "boost/shared_ptr.hpp"
+
 #include "IECore/Spline.h"
 
 #include "Gaffer/CompoundPlug.h"
 #include "Gaffer/NumericPlug.h"
 #include "Gaffer/TypedPlug.h"
 #include "Gaffer/PlugType.h"
+#include "Gaffer/SplineLUT.h"
 
 namespace Gaffer
 {
@@ -98,6 +103,13 @@ class SplinePlug : public CompoundPlug
 		/// from the basis, points and endPointMultiplicity plugs.
 		T getValue() const;
 		
+		typedef SplineLUT<T> LUT;
+		typedef boost::shared_ptr<const LUT> ConstLUTPtr;
+		/// Returns a baked representation of the current value, suitable
+		/// for the efficient evaluation of many samples. The LUT is cached,
+		/// and is only rebuilt when the hash of the plug changes.
+		ConstLUTPtr getLUT() const;
+		
 		CompoundPlug *basisPlug();
 		const CompoundPlug *basisPlug() const;
 		M44fPlug *basisMatrixPlug();
@@ -133,6 +145,10 @@ class SplinePlug : public CompoundPlug
 
 		T m_defaultValue;
 
+		mutable tbb::spin_mutex m_lutMutex;
+		mutable IECore::MurmurHash m_lutHash;
+		mutable ConstLUTPtr m_lut;
+
 };
 
 typedef SplinePlug<IECore::Splineff> SplineffPlug;
@@ -38,6 +38,8 @@
 #ifndef GAFFER_VALUEPLUG_H
 #define GAFFER_VALUEPLUG_H
 
+#include "tbb/atomic.h"
+
 #include "Gaffer/Plug.h"
 #include "Gaffer/PlugIterator.h"
 
@@ -100,6 +102,92 @@ class ValuePlug : public Plug
 		static void setCacheMemoryLimit( size_t bytes );
 		/// Returns the current memory usage of the cache in bytes.
 		static size_t cacheMemoryUsage();
+		/// Policies which ComputeNodes may use to control the caching
+		/// of their outputs - see ComputeNode::cachePolicy().
+		enum CachePolicy
+		{
+			/// The value is computed from scratch every time.
+			Uncached,
+			/// The value is stored in the cache.
+			Cached,
+			/// The value is stored in the cache only if its computation
+			/// took longer than ComputeNode::cacheComputeTimeThreshold().
+			CachedIfExpensive,
+			/// The value is stored in a separate pool with its own memory
+			/// limit, so that it can't be evicted by the values of other
+			/// nodes.
+			CachedInPool
+		};
+		/// Returns the memory used by values cached with the specified
+		/// policy.
+		static size_t cacheMemoryUsage( CachePolicy policy );
+		/// Returns the maximum amount of memory in bytes to use for
+		/// values with the CachedInPool policy.
+		static size_t getCachePoolMemoryLimit();
+		static void setCachePoolMemoryLimit( size_t bytes );
+		/// Returns the default minimum compute time in microseconds for
+		/// values with the CachedIfExpensive policy to be cached. Nodes may
+		/// override this per output - see ComputeNode::cacheComputeTimeThreshold().
+		static size_t getCacheComputeTimeThreshold();
+		static void setCacheComputeTimeThreshold( size_t microseconds );
+		/// Policies for choosing which entries to evict from the cache
+		/// when the memory limit is reached.
+		enum CacheEvictionPolicy
+		{
+			/// Evicts the entries which were accessed least recently.
+			LeastRecentlyUsed,
+			/// Weights entries by the time taken to compute them per byte
+			/// of memory used, so that expensive values are retained in
+			/// preference to cheap ones. This uses the GreedyDual-Size
+			/// algorithm, so entries which are no longer accessed are
+			/// eventually evicted regardless of cost.
+			CostAware
+		};
+		static CacheEvictionPolicy getCacheEvictionPolicy();
+		/// Sets the eviction policy. Existing entries are retained.
+		static void setCacheEvictionPolicy( CacheEvictionPolicy policy );
+		/// The cache is divided into a number of independent shards, so
+		/// that threads accessing different entries do not contend for
+		/// the same locks. Each entry is assigned to a shard according to
+		/// its hash. The memory limit applies to all shards collectively,
+		/// and eviction chooses the lowest priority entry from any shard.
+		static size_t numCacheShards();
+		/// Statistics describing the activity of a single cache shard.
+		struct CacheStatistics
+		{
+			size_t hits;
+			size_t misses;
+			size_t evictions;
+			size_t memoryUsage;
+		};
+		/// Returns the statistics for the specified shard, in the range
+		/// [ 0, numCacheShards() ).
+		static CacheStatistics cacheStatistics( size_t shard );
+		/// As above, but for the separate pool used for values with the
+		/// CachedInPool policy, which is sharded in the same way.
+		static CacheStatistics cachePoolStatistics( size_t shard );
+		/// Resets the hit, miss and eviction counts for all shards of
+		/// both the cache and the pool.
+		static void resetCacheStatistics();
+		/// Returns the maximum amount of memory in bytes to use for
+		/// the cache of hashes. Hashes for computed plugs are cached
+		/// per plug and per context, and are invalidated when the plug
+		/// is dirtied.
+		static size_t getHashCacheMemoryLimit();
+		/// Sets the maximum amount of memory the hash cache may use in
+		/// bytes. A limit of 0 disables hash caching entirely.
+		static void setHashCacheMemoryLimit( size_t bytes );
+		/// Returns the current memory usage of the hash cache in bytes.
+		static size_t hashCacheMemoryUsage();
+		/// Returns the number of hash cache hits since the cache was
+		/// last cleared.
+		static size_t hashCacheHits();
+		/// Returns the number of hash cache misses since the cache was
+		/// last cleared.
+		static size_t hashCacheMisses();
+		/// Removes all entries from the hash cache, and resets the
+		/// hit and miss counts.
+		static void clearHashCache();
 		//@}
 
 	protected :
@@ -151,12 +239,24 @@ class ValuePlug : public Plug
 		class Computation;
 		friend class Computation;
 
+		class HashCache;
+		friend class HashCache;
+
 		class SetValueAction;
+
+		friend class DependencyNode;
 	
 		void setValueInternal( IECore::ConstObjectPtr value, bool propagateDirtiness );
+		/// Called by DependencyNode::propagateDirtiness() to invalidate
+		/// any cached hashes for this plug.
+		void dirty();
 		
 		/// For holding the value of input plugs with no input connections.
 		IECore::ConstObjectPtr m_staticValue;
+		/// Incremented each time the plug is dirtied, and used to key
+		/// the hash cache. Atomic because it is written during dirty
+		/// propagation while compute threads may be reading it.
+		tbb::atomic<uint64_t> m_dirtyCount;
 
 };
 
@@ -42,6 +42,7 @@
 #include "Gaffer/ExecutableNode.h"
 
 #include "GafferBindings/NodeBinding.h"
+#include "GafferBindings/TranslatePythonException.h"
 
 namespace GafferBindings
 {
@@ -107,6 +108,44 @@ class ExecutableNodeWrapper : public NodeWrapper<WrappedType>
 			return WrappedType::executionHash( context );
 		}
 		
+		virtual void executionOutputs( const Gaffer::Context *context, std::vector<std::string> &fileNames ) const
+		{
+			IECorePython::ScopedGILLock gilLock;
+			if( this->isSubclassed() )
+			{
+				boost::python::object o = this->methodOverride( "executionOutputs" );
+				if( o )
+				{
+					boost::python::list fileNameList = boost::python::extract<boost::python::list>(
+						o( Gaffer::ContextPtr( const_cast<Gaffer::Context *>( context ) ) )
+					);
+					
+					size_t len = boost::python::len( fileNameList );
+					fileNames.reserve( len );
+					for( size_t i = 0; i < len; i++ )
+					{
+						fileNames.push_back( boost::python::extract<std::string>( fileNameList[i] ) );
+					}
+					return;
+				}
+			}
+			WrappedType::executionOutputs( context, fileNames );
+		}
+		
+		virtual bool executionHashIsComplete() const
+		{
+			IECorePython::ScopedGILLock gilLock;
+			if( this->isSubclassed() )
+			{
+				boost::python::object c = this->methodOverride( "executionHashIsComplete" );
+				if( c )
+				{
+					return boost::python::extract<bool>( c() );
+				}
+			}
+			return WrappedType::executionHashIsComplete();
+		}
+		
 		virtual void execute( const Gaffer::ExecutableNode::Contexts &contexts ) const
 		{
 			IECorePython::ScopedGILLock gilLock;
@@ -120,7 +159,14 @@ class ExecutableNodeWrapper : public NodeWrapper<WrappedType>
 					{
 						contextList.append( *cIt );
 					}
-					exec( contextList );
+					try
+					{
+						exec( contextList );
+					}
+					catch( const boost::python::error_already_set &e )
+					{
+						translatePythonException();
+					}
 					return;
 				}
 			}
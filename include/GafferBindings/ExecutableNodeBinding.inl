@@ -66,6 +66,25 @@ IECore::MurmurHash executionHash( T &n, const Gaffer::Context *context )
 	return n.T::executionHash( context );
 }
 
+template<typename T>
+boost::python::list executionOutputs( T &n, const Gaffer::Context *context )
+{
+	std::vector<std::string> fileNames;
+	n.T::executionOutputs( context, fileNames );
+	boost::python::list result;
+	for( std::vector<std::string>::const_iterator it = fileNames.begin(); it != fileNames.end(); ++it )
+	{
+		result.append( *it );
+	}
+	return result;
+}
+
+template<typename T>
+bool executionHashIsComplete( T &n )
+{
+	return n.T::executionHashIsComplete();
+}
+
 template<typename T>
 void execute( T &n, const boost::python::list &contextsList )
 {
@@ -83,6 +102,8 @@ ExecutableNodeClass<T, Ptr>::ExecutableNodeClass( const char *docString )
 {
 	def( "executionRequirements", &Detail::executionRequirements<T> );
 	def( "executionHash", &Detail::executionHash<T> );
+	def( "executionOutputs", &Detail::executionOutputs<T> );
+	def( "executionHashIsComplete", &Detail::executionHashIsComplete<T> );
 	def( "execute", &Detail::execute<T> );	
 }
 
@@ -65,6 +65,10 @@ class ColorProcessor : public ImageProcessor
 	
 		virtual void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 		virtual void compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const;
+		/// Implemented to disable caching for the channel data. Because our implementation
+		/// of computeChannelData() is so simple, just copying data out of an intermediate
+		/// plug, it is actually quicker not to cache the result.
+		virtual Gaffer::ValuePlug::CachePolicy cachePolicy( const Gaffer::ValuePlug *output ) const;
 
 		/// Implemented to pass through the hashes from the input plug.
 		virtual void hashFormat( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
@@ -76,6 +76,9 @@ class ImagePrimitiveSource : public BaseType
 		virtual void hashChannelData( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 
 		virtual void compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const;
+		/// Implemented to disable caching on our outputs, as we're basically caching the
+		/// entire image ourselves in __inputImagePrimitive.
+		virtual Gaffer::ValuePlug::CachePolicy cachePolicy( const Gaffer::ValuePlug *output ) const;
 		virtual GafferImage::Format computeFormat( const Gaffer::Context *context, const ImagePlug *parent ) const;
 		virtual Imath::Box2i computeDataWindow( const Gaffer::Context *context, const ImagePlug *parent ) const;
 		virtual IECore::ConstStringVectorDataPtr computeChannelNames( const Gaffer::Context *context, const ImagePlug *parent ) const;
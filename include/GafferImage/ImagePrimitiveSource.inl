@@ -56,13 +56,6 @@ ImagePrimitiveSource<BaseType>::ImagePrimitiveSource( const std::string &name )
 	BaseType::addChild( new Gaffer::ObjectPlug( "__imagePrimitive", Gaffer::Plug::Out, IECore::NullObject::defaultNullObject() ) );
 	BaseType::addChild( new Gaffer::ObjectPlug( "__inputImagePrimitive", Gaffer::Plug::In, IECore::NullObject::defaultNullObject(), Gaffer::Plug::Default & ~Gaffer::Plug::Serialisable ) );
 	inputImagePrimitivePlug()->setInput( imagePrimitivePlug() );
-
-	// disable caching on our outputs, as we're basically caching the entire
-	// image ourselves in __inputImagePrimitive.
-	for( Gaffer::OutputPlugIterator it( BaseType::outPlug() ); it!=it.end(); it++ )
-	{
-		(*it)->setFlags( Gaffer::Plug::Cacheable, false );
-	}
 }
 
 template<typename BaseType>
@@ -163,6 +156,16 @@ void ImagePrimitiveSource<BaseType>::compute( Gaffer::ValuePlug *output, const G
 	return BaseType::compute( output, context );
 }
 
+template<typename BaseType>
+Gaffer::ValuePlug::CachePolicy ImagePrimitiveSource<BaseType>::cachePolicy( const Gaffer::ValuePlug *output ) const
+{
+	if( output->parent<Gaffer::Plug>() == BaseType::outPlug() )
+	{
+		return Gaffer::ValuePlug::Uncached;
+	}
+	return BaseType::cachePolicy( output );
+}
+
 template<typename BaseType>
 GafferImage::Format ImagePrimitiveSource<BaseType>::computeFormat( const Gaffer::Context *context, const ImagePlug *parent ) const
 {
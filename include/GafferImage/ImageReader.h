@@ -68,6 +68,10 @@ class ImageReader : public ImageNode
 		
 	protected :
 		
+		/// Implemented to disable caching on our outputs, as OIIO is already
+		/// doing caching for us.
+		virtual Gaffer::ValuePlug::CachePolicy cachePolicy( const Gaffer::ValuePlug *output ) const;
+		
 		virtual void hashFormat( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 		virtual void hashChannelNames( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 		virtual void hashDataWindow( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
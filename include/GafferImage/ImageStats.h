@@ -40,6 +40,7 @@
 #include "Gaffer/ComputeNode.h"
 #include "Gaffer/CompoundNumericPlug.h"
 #include "Gaffer/BoxPlug.h"
+#include "Gaffer/TypedObjectPlug.h"
 
 #include "GafferImage/ImagePlug.h"
 #include "GafferImage/ChannelMaskPlug.h"
@@ -49,6 +50,8 @@ namespace GafferImage
 
 /// Provides statistics on an image's colour profile. 
 /// The ImageStats node outputs the minimum, maximum and average values of the pixel values within a region of interest in the image.
+/// It also outputs a histogram for each channel, along with the value at a user specified percentile. The percentile is
+/// estimated from the histogram, so its accuracy is limited by the width of the histogram bins.
 class ImageStats : public Gaffer::ComputeNode
 {
 
@@ -73,6 +76,22 @@ class ImageStats : public Gaffer::ComputeNode
 		const Gaffer::Color4fPlug *minPlug() const;
 		Gaffer::Color4fPlug *maxPlug();
 		const Gaffer::Color4fPlug *maxPlug() const;
+		/// The range of values covered by the histogram. Values outside
+		/// this range are counted in the first or last bin.
+		Gaffer::V2fPlug *histogramRangePlug();
+		const Gaffer::V2fPlug *histogramRangePlug() const;
+		Gaffer::IntPlug *histogramBinsPlug();
+		const Gaffer::IntPlug *histogramBinsPlug() const;
+		/// Outputs a CompoundData containing an IntVectorData of bin
+		/// counts for each of the channels.
+		Gaffer::ObjectPlug *histogramPlug();
+		const Gaffer::ObjectPlug *histogramPlug() const;
+		/// The percentile, in the range 0-100, to be output
+		/// by the percentileValuePlug().
+		Gaffer::FloatPlug *percentilePlug();
+		const Gaffer::FloatPlug *percentilePlug() const;
+		Gaffer::Color4fPlug *percentileValuePlug();
+		const Gaffer::Color4fPlug *percentileValuePlug() const;
 
 	protected :
 	
@@ -84,6 +103,16 @@ class ImageStats : public Gaffer::ComputeNode
 
 	private :
 		
+		/// All the statistics for the channel specified by the context are
+		/// computed in a single parallel pass over the tiles of the region of interest,
+		/// and stored on this intermediate plug, from which the outputs are then
+		/// retrieved.
+		Gaffer::ObjectPlug *statisticsPlug();
+		const Gaffer::ObjectPlug *statisticsPlug() const;
+
+		void hashStatistics( const Gaffer::Context *context, IECore::MurmurHash &h ) const;
+		IECore::ConstObjectPtr computeStatistics( const Gaffer::Context *context ) const;
+
 		void inputChanged( Gaffer::Plug *plug );
 
 		/// Sets channelName to the channel which corresponds to the output plug. The channel name is
@@ -77,6 +77,9 @@ class ImageWriter : public Gaffer::ExecutableNode
 		const Gaffer::IntPlug *writeModePlug() const;
 		
 		virtual IECore::MurmurHash executionHash( const Gaffer::Context *context ) const;
+		virtual void executionOutputs( const Gaffer::Context *context, std::vector<std::string> &fileNames ) const;
+		/// Returns true, as the execution hash includes the hash of the whole image.
+		virtual bool executionHashIsComplete() const;
 
 		virtual void execute( const Contexts &contexts ) const;
 
@@ -38,6 +38,7 @@
 #define GAFFERIMAGE_MERGE_H
 
 #include "GafferImage/FilterProcessor.h"
+#include "GafferImage/VectorTraits.h"
 
 namespace GafferImage
 {
@@ -104,9 +105,10 @@ class Merge : public FilterProcessor
 	
 	private :
 		
-		/// Performs the merge operation using the functor 'F'.
-		template< typename F >
-		IECore::ConstFloatVectorDataPtr doMergeOperation( F f, std::vector< IECore::ConstFloatVectorDataPtr > &inData, std::vector< IECore::ConstFloatVectorDataPtr > &inAlpha, const Imath::V2i &tileOrigin ) const;
+		/// Performs the merge operation defined by 'Op', which must be one of the
+		/// operation structs in the Detail namespace of Merge.inl.
+		template< typename Op >
+		IECore::ConstFloatVectorDataPtr doMergeOperation( const std::vector< IECore::ConstFloatVectorDataPtr > &inData, const std::vector< IECore::ConstFloatVectorDataPtr > &inAlpha ) const;
 
 		/// A useful method which returns true if the StringVector contains the channel "A".
 		inline bool hasAlpha( IECore::ConstStringVectorDataPtr channelNamesData ) const;
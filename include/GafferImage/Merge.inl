@@ -34,43 +34,168 @@
 //  
 //////////////////////////////////////////////////////////////////////////
 
-template< typename F >
-IECore::ConstFloatVectorDataPtr Merge::doMergeOperation( F f, std::vector< IECore::ConstFloatVectorDataPtr > &inData, std::vector< IECore::ConstFloatVectorDataPtr > &inAlpha, const Imath::V2i &tileOrigin ) const
+namespace Detail
 {
-	// Allocate the new tile
-	Imath::Box2i tile( tileOrigin, Imath::V2i( tileOrigin.x + ImagePlug::tileSize() - 1, tileOrigin.y + ImagePlug::tileSize() - 1 ) );
-	IECore::FloatVectorDataPtr outDataPtr = inData.back()->copy();
-	std::vector<float> &outData = outDataPtr->writable();
 
-	// Allocate a temporary tile that will hold the intermediate values of the alpha channel.
-	IECore::FloatVectorDataPtr aOut = inAlpha.back()->copy();
-	std::vector<float> &outAlpha = aOut->writable();
-	
-	// Perform the operation.
-	unsigned int nIterations( inData.size() -1 );
-	for( unsigned int i = nIterations; i > 0; --i )
+/// The merge operations. Each combines the A and B values, given their
+/// alphas a and b.
+
+struct AddOp
+{
+	template<typename T>
+	static inline typename T::Vector apply( typename T::Vector A, typename T::Vector B, typename T::Vector a, typename T::Vector b )
 	{
-		for( int y = tile.min.y; y<=tile.max.y; y++ )
-		{
-			// Compute the data values and afterwards, the intermediate alpha values.
-			const float *dIn1 = &(outData[0]) + ( y - tileOrigin.y ) * ImagePlug::tileSize() + (tile.min.x - tileOrigin.x);
-			const float *dIn2 = &(inData[i-1]->readable()[0]) + (y - tileOrigin.y) * ImagePlug::tileSize() + (tile.min.x - tileOrigin.x);	
-			const float *aIn1 = &(outAlpha[0]) + ( y - tileOrigin.y ) * ImagePlug::tileSize() + (tile.min.x - tileOrigin.x);
-			const float *aIn2 = &(inAlpha[i-1]->readable()[0]) + (y - tileOrigin.y) * ImagePlug::tileSize() + (tile.min.x - tileOrigin.x);
-
-			float *dOut = &(outData[0]) + ( y - tileOrigin.y ) * ImagePlug::tileSize() + (tile.min.x - tileOrigin.x);
-			float *aOut = &(outAlpha[0]) + ( y - tileOrigin.y ) * ImagePlug::tileSize() + (tile.min.x - tileOrigin.x);
-
-			const float *END = dOut+(tile.max.x-tile.min.x)+1;
-			while( dOut != END )
-			{
-				*dOut++ = f( *dIn1++, *dIn2++, *aIn1, *aIn2 );
-				*aOut++ = f( *aIn1, *aIn2, *aIn1, *aIn2 );
-				++aIn1;
-				++aIn2;
-			}	
-		}
+		return T::add( A, B );
+	}
+};
+
+struct AtopOp
+{
+	template<typename T>
+	static inline typename T::Vector apply( typename T::Vector A, typename T::Vector B, typename T::Vector a, typename T::Vector b )
+	{
+		return T::add( T::mul( A, b ), T::mul( B, T::sub( T::set( 1.0f ), a ) ) );
+	}
+};
+
+struct DivideOp
+{
+	template<typename T>
+	static inline typename T::Vector apply( typename T::Vector A, typename T::Vector B, typename T::Vector a, typename T::Vector b )
+	{
+		return T::div( A, B );
+	}
+};
+
+struct InOp
+{
+	template<typename T>
+	static inline typename T::Vector apply( typename T::Vector A, typename T::Vector B, typename T::Vector a, typename T::Vector b )
+	{
+		return T::mul( A, b );
+	}
+};
+
+struct OutOp
+{
+	template<typename T>
+	static inline typename T::Vector apply( typename T::Vector A, typename T::Vector B, typename T::Vector a, typename T::Vector b )
+	{
+		return T::mul( A, T::sub( T::set( 1.0f ), b ) );
+	}
+};
+
+struct MaskOp
+{
+	template<typename T>
+	static inline typename T::Vector apply( typename T::Vector A, typename T::Vector B, typename T::Vector a, typename T::Vector b )
+	{
+		return T::mul( B, a );
+	}
+};
+
+struct MatteOp
+{
+	template<typename T>
+	static inline typename T::Vector apply( typename T::Vector A, typename T::Vector B, typename T::Vector a, typename T::Vector b )
+	{
+		return T::add( T::mul( A, a ), T::mul( B, T::sub( T::set( 1.0f ), a ) ) );
+	}
+};
+
+struct MultiplyOp
+{
+	template<typename T>
+	static inline typename T::Vector apply( typename T::Vector A, typename T::Vector B, typename T::Vector a, typename T::Vector b )
+	{
+		return T::mul( A, B );
+	}
+};
+
+struct OverOp
+{
+	template<typename T>
+	static inline typename T::Vector apply( typename T::Vector A, typename T::Vector B, typename T::Vector a, typename T::Vector b )
+	{
+		return T::add( A, T::mul( B, T::sub( T::set( 1.0f ), a ) ) );
+	}
+};
+
+struct SubtractOp
+{
+	template<typename T>
+	static inline typename T::Vector apply( typename T::Vector A, typename T::Vector B, typename T::Vector a, typename T::Vector b )
+	{
+		return T::sub( A, B );
+	}
+};
+
+struct UnderOp
+{
+	template<typename T>
+	static inline typename T::Vector apply( typename T::Vector A, typename T::Vector B, typename T::Vector a, typename T::Vector b )
+	{
+		return T::add( T::mul( A, T::sub( T::set( 1.0f ), b ) ), B );
+	}
+};
+
+/// Merges T::width pixels starting at index i. The last input provides the
+/// initial value, and each preceding input is then combined with the result
+/// in turn, with the running alpha being merged using the same operation.
+template<typename Op, typename T>
+inline void mergePixels( const float * const *data, const float * const *alpha, size_t numInputs, float *out, size_t i )
+{
+	typename T::Vector d = T::load( data[numInputs-1] + i );
+	typename T::Vector a = T::load( alpha[numInputs-1] + i );
+	for( size_t j = numInputs - 1; j > 0; --j )
+	{
+		const typename T::Vector dIn = T::load( data[j-1] + i );
+		const typename T::Vector aIn = T::load( alpha[j-1] + i );
+		d = Op::template apply<T>( d, dIn, a, aIn );
+		a = Op::template apply<T>( a, aIn, a, aIn );
+	}
+	T::store( out + i, d );
+}
+
+/// Merges numInputs arrays of size values into out, using the vector type
+/// provided by T for as much of the array as possible, and scalar code for
+/// any remainder. Looping over the pixels in the outer loop and the inputs
+/// in the inner one keeps the intermediate results in registers, so each
+/// input is read only once and the output is written only once.
+template<typename Op, typename T>
+void mergeArrays( const float * const *data, const float * const *alpha, size_t numInputs, float *out, size_t size )
+{
+	size_t i = 0;
+	for( ; i + T::width <= size; i += T::width )
+	{
+		mergePixels<Op, T>( data, alpha, numInputs, out, i );
+	}
+	for( ; i < size; ++i )
+	{
+		mergePixels<Op, ScalarTraits>( data, alpha, numInputs, out, i );
 	}
-	return outDataPtr;
 }
 
+} // namespace Detail
+
+template< typename Op >
+IECore::ConstFloatVectorDataPtr Merge::doMergeOperation( const std::vector< IECore::ConstFloatVectorDataPtr > &inData, const std::vector< IECore::ConstFloatVectorDataPtr > &inAlpha ) const
+{
+	std::vector<const float *> data;
+	std::vector<const float *> alpha;
+	data.reserve( inData.size() );
+	alpha.reserve( inAlpha.size() );
+	for( size_t i = 0, e = inData.size(); i < e; ++i )
+	{
+		data.push_back( &(inData[i]->readable()[0]) );
+		alpha.push_back( &(inAlpha[i]->readable()[0]) );
+	}
+
+	IECore::FloatVectorDataPtr outDataPtr = new IECore::FloatVectorData;
+	std::vector<float> &outData = outDataPtr->writable();
+	outData.resize( ImagePlug::tileSize() * ImagePlug::tileSize() );
+
+	Detail::mergeArrays<Op, Detail::NativeTraits>( &(data[0]), &(alpha[0]), data.size(), &(outData[0]), outData.size() );
+
+	return outDataPtr;
+}
@@ -68,6 +68,11 @@ class Reformat : public ImageProcessor
 				
 	protected :
 		
+		/// Implemented to place our channel data in the pool cache, so that
+		/// the resampled tiles of large images don't evict the results of
+		/// other nodes from the main cache.
+		virtual Gaffer::ValuePlug::CachePolicy cachePolicy( const Gaffer::ValuePlug *output ) const;
+
 		virtual void hashFormat( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 		virtual void hashChannelNames( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 		virtual void hashDataWindow( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
@@ -78,10 +83,10 @@ class Reformat : public ImageProcessor
 		virtual IECore::ConstStringVectorDataPtr computeChannelNames( const Gaffer::Context *context, const ImagePlug *parent ) const;
 
 		/// Reformats the input plug with a filter by doing a 2-pass squash/stretch.
-		/// We reformat the image by doing two passes over the input in first the horizontal and then vertical directions.
-		/// On each pass we use the chosen filter to create a (row or column) buffer of pixels their weighted contributeion to each pixel on the row or column.
-		/// Using this column/row buffer we iterate over the input and sum the contributing pixels. The result is normalized by the sum of weights.
-		/// This process is repeated once for the vertical and horizontal passes and the final result is written into the output buffer.
+		/// We reformat the image by doing two passes over the input in first the vertical and then horizontal directions.
+		/// For each pass we use the chosen filter to compute the contributing pixels for each output row or column, along
+		/// with their weights normalized by their sum. These are cached, so they can be shared between all the tiles in a
+		/// row or column. Each pass then sums whole rows of contributing pixels, weighted, into the rows of its result.
 		virtual IECore::ConstFloatVectorDataPtr computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const;
 		
 		// Computes the output scale factor from the input and output formats.
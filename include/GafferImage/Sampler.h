@@ -82,6 +82,21 @@ class Sampler
 		/// Sub-samples the image using a filter.
 		inline float sample( float x, float y );
 
+		/// Fills result with the values of the width pixels starting at x, y
+		/// and proceeding along the row. This is equivalent to calling sample( int, int )
+		/// for each pixel in turn, but is much faster as the values are copied from
+		/// each tile in contiguous spans.
+		void sampleRow( int x, int y, int width, float *result );
+
+		/// Fills result with the values of the pixels within region, in
+		/// row-major order.
+		void sampleBlock( const Imath::Box2i &region, float *result );
+
+		/// Fetches all the tiles required by the sample window in parallel. Calling
+		/// this before sampling is beneficial when most of the sample window will be
+		/// accessed, as otherwise tiles are fetched serially on demand.
+		void prefetch();
+
 		/// Accumulates the hashes of the tiles that it accesses.
 		void hash( IECore::MurmurHash &h ) const;
 
@@ -106,6 +121,9 @@ class Sampler
 		BoundingMode m_boundingMode;
 		ConstFilterPtr m_filter;
 
+		std::vector<float> m_weightsX;
+		std::vector<float> m_weightsY;
+
 };
 
 }; // namespace GafferImage
@@ -53,23 +53,22 @@ float Sampler::sample( float x, float y )
 		return sample( IECore::fastFloatFloor( x ), IECore::fastFloatFloor( y ) );
 	}
 
-	// Otherwise do a filtered lookup.	
-	int tapX = m_filter->tap( x - m_cacheWindow.min.x );
+	// Otherwise do a filtered lookup.
 	const int width = m_filter->width();
-	float weightsX[width];
+	m_weightsX.resize( width );
+	m_weightsY.resize( width );
 	
+	int tapX = m_filter->tap( x - m_cacheWindow.min.x );
 	for ( int i = 0; i < width; ++i )
 	{
-		weightsX[i] = m_filter->weight( x, tapX+i+m_cacheWindow.min.x );
+		m_weightsX[i] = m_filter->weight( x, tapX+i+m_cacheWindow.min.x );
 	}
 
 	int tapY = m_filter->tap( y - m_cacheWindow.min.y );
-	const int height = m_filter->width();
-	float weightsY[height];
-	
+	const int height = width;
 	for ( int i = 0; i < height; ++i )
 	{
-		weightsY[i] = m_filter->weight( y, tapY+i+m_cacheWindow.min.y );
+		m_weightsY[i] = m_filter->weight( y, tapY+i+m_cacheWindow.min.y );
 	}
 
 	float weightedSum = 0.;
@@ -81,7 +80,7 @@ float Sampler::sample( float x, float y )
 		for ( int x = 0; x < width; ++x, ++absX )
 		{
 			float c = 0.;
-			float w = weightsX[x] * weightsY[y];		
+			float w = m_weightsX[x] * m_weightsY[y];		
 			c = sample( absX, absY );
 			weightedSum += w;
 			colour += c * w;
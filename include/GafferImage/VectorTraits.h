@@ -0,0 +1,124 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2014, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERIMAGE_VECTORTRAITS_H
+#define GAFFERIMAGE_VECTORTRAITS_H
+
+#include <cstddef>
+
+#if defined( __AVX__ )
+#include <immintrin.h>
+#elif defined( __SSE__ )
+#include <xmmintrin.h>
+#endif
+
+namespace GafferImage
+{
+
+namespace Detail
+{
+
+/// Traits classes providing a handful of arithmetic operations for a single
+/// float and for each of the SIMD vector types we support. Image processing
+/// kernels can be written once in terms of these and instantiated for both,
+/// and as long as they perform the same sequence of single precision
+/// operations, the SIMD and scalar versions will produce identical results.
+/// This relies on the compiler not contracting separate multiplies and adds
+/// into fused multiply-adds, which it may do in one version and not the
+/// other, so code using these traits must be built with -ffp-contract=off
+/// where the compiler supports it. The SConstruct does this for GafferImage
+/// and GafferImageTest.
+struct ScalarTraits
+{
+	typedef float Vector;
+	static const size_t width = 1;
+	static inline Vector load( const float *p ) { return *p; }
+	static inline void store( float *p, Vector v ) { *p = v; }
+	static inline Vector set( float f ) { return f; }
+	static inline Vector add( Vector a, Vector b ) { return a + b; }
+	static inline Vector sub( Vector a, Vector b ) { return a - b; }
+	static inline Vector mul( Vector a, Vector b ) { return a * b; }
+	static inline Vector div( Vector a, Vector b ) { return a / b; }
+};
+
+#if defined( __SSE__ )
+
+struct SSETraits
+{
+	typedef __m128 Vector;
+	static const size_t width = 4;
+	static inline Vector load( const float *p ) { return _mm_loadu_ps( p ); }
+	static inline void store( float *p, Vector v ) { _mm_storeu_ps( p, v ); }
+	static inline Vector set( float f ) { return _mm_set1_ps( f ); }
+	static inline Vector add( Vector a, Vector b ) { return _mm_add_ps( a, b ); }
+	static inline Vector sub( Vector a, Vector b ) { return _mm_sub_ps( a, b ); }
+	static inline Vector mul( Vector a, Vector b ) { return _mm_mul_ps( a, b ); }
+	static inline Vector div( Vector a, Vector b ) { return _mm_div_ps( a, b ); }
+};
+
+#endif
+
+#if defined( __AVX__ )
+
+struct AVXTraits
+{
+	typedef __m256 Vector;
+	static const size_t width = 8;
+	static inline Vector load( const float *p ) { return _mm256_loadu_ps( p ); }
+	static inline void store( float *p, Vector v ) { _mm256_storeu_ps( p, v ); }
+	static inline Vector set( float f ) { return _mm256_set1_ps( f ); }
+	static inline Vector add( Vector a, Vector b ) { return _mm256_add_ps( a, b ); }
+	static inline Vector sub( Vector a, Vector b ) { return _mm256_sub_ps( a, b ); }
+	static inline Vector mul( Vector a, Vector b ) { return _mm256_mul_ps( a, b ); }
+	static inline Vector div( Vector a, Vector b ) { return _mm256_div_ps( a, b ); }
+};
+
+#endif
+
+/// The widest traits available for the instruction set we're compiling for.
+#if defined( __AVX__ )
+typedef AVXTraits NativeTraits;
+#elif defined( __SSE__ )
+typedef SSETraits NativeTraits;
+#else
+typedef ScalarTraits NativeTraits;
+#endif
+
+} // namespace Detail
+
+} // namespace GafferImage
+
+#endif // GAFFERIMAGE_VECTORTRAITS_H
@@ -72,6 +72,10 @@ class OSLImage : public GafferImage::ImageProcessor
 		virtual void hashChannelData( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 
 		virtual void compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const;
+		/// Implemented to disable caching for the channel data plug, because our compute
+		/// simply references data direct from the shading plug, which will itself be cached.
+		/// We don't want to count the memory usage for that twice.
+		virtual Gaffer::ValuePlug::CachePolicy cachePolicy( const Gaffer::ValuePlug *output ) const;
 		virtual GafferImage::Format computeFormat( const Gaffer::Context *context, const GafferImage::ImagePlug *parent ) const;
 		virtual Imath::Box2i computeDataWindow( const Gaffer::Context *context, const GafferImage::ImagePlug *parent ) const;
 		virtual IECore::ConstStringVectorDataPtr computeChannelNames( const Gaffer::Context *context, const GafferImage::ImagePlug *parent ) const;
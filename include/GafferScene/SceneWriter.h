@@ -66,13 +66,12 @@ class SceneWriter : public Gaffer::ExecutableNode
 		const ScenePlug *inPlug() const;
 		
 		virtual IECore::MurmurHash executionHash( const Gaffer::Context *context ) const;
+		virtual void executionOutputs( const Gaffer::Context *context, std::vector<std::string> &fileNames ) const;
 		
 		virtual void execute( const Contexts &contexts ) const;
 		
 	private :
 	
-		void writeLocation( const GafferScene::ScenePlug *scene, const ScenePlug::ScenePath &scenePath, Gaffer::Context *context, IECore::SceneInterface *output, double time ) const;
-		
 		static size_t g_firstPlugIndex;
 		
 		static const double g_frameRate;
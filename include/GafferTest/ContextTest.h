@@ -41,6 +41,8 @@ namespace GafferTest
 {
 
 void testManyContexts();
+void testEditableScope();
+void testManyEditableScopes();
 
 } // namespace GafferTest
 
@@ -35,6 +35,7 @@
 ##########################################################################
 
 import os
+import time
 import errno
 import subprocess
 
@@ -46,6 +47,16 @@ class LocalDispatcher( Gaffer.Dispatcher ) :
 	def __init__( self, name = "LocalDispatcher" ) :
 
 		Gaffer.Dispatcher.__init__( self, name )
+		
+		# The maximum number of processes which may be executing at once.
+		# This defaults to 1 because the tasks may themselves be multithreaded
+		# or memory hungry, so running them in parallel must be opted into.
+		self["maxWorkers"] = Gaffer.IntPlug( defaultValue = 1, minValue = 1 )
+		# The maximum number of frames of a single node to be executed by each
+		# process. A value of 0 divides the frames of each node evenly between
+		# the available workers, so that script loading costs are only paid
+		# once per worker.
+		self["framesPerBatch"] = Gaffer.IntPlug( defaultValue = 0, minValue = 0 )
 	
 	def jobDirectory( self, context ) :
 		
@@ -77,44 +88,178 @@ class LocalDispatcher( Gaffer.Dispatcher ) :
 		tmpScript = os.path.join( jobDirectory, os.path.basename( scriptFileName ) if scriptFileName else "untitled.gfr" )
 		script.serialiseToFile( tmpScript )
 		
-		for ( task, requirements ) in taskDescriptions :
-			
-			taskContext = task.context()
-			frames = str(int(taskContext.getFrame()))
-			
-			cmd = [
-				"gaffer", "execute",
-				"-script", tmpScript,
-				"-nodes", task.node().relativeName( script ),
-				"-frames", frames,
-			]
-			
-			contextArgs = []
-			for entry in taskContext.keys() :
-				if entry != "frame" and ( entry not in script.context().keys() or taskContext[entry] != script.context()[entry] ) :
-					contextArgs.extend( [ "-" + entry, repr(taskContext[entry]) ] )
+		ledgerFileName = context.substitute( self["executionLedger"].getValue() )
+		ledger = Gaffer.ExecutionLedger( ledgerFileName ) if ledgerFileName else None
+		
+		maxWorkers = self["maxWorkers"].getValue()
+		batches = self.__batches( script, taskDescriptions, maxWorkers )
+		
+		# Launch each batch as soon as all the batches it depends on have
+		# completed, keeping up to maxWorkers processes running at once.
+		
+		jobStartTime = time.time()
+		pending = list( batches )
+		running = []
+		failed = False
+		try :
 			
-			if contextArgs :
-				cmd.extend( [ "-context" ] + contextArgs )
+			while pending or running :
+				
+				if not failed :
+					i = 0
+					while i < len( pending ) and len( running ) < maxWorkers :
+						batch = pending[i]
+						if all( r.completed for r in batch.requirements ) :
+							cmd = batch.command( tmpScript )
+							IECore.msg( IECore.MessageHandler.Level.Info, messageContext, " ".join( cmd ) )
+							batch.startTime = time.time()
+							batch.process = subprocess.Popen( cmd )
+							running.append( batch )
+							del pending[i]
+						else :
+							i += 1
+				
+				if not running :
+					break
+				
+				# We poll our own processes rather than using os.wait(), which
+				# would reap any child of this process, stealing the exit
+				# status of subprocesses launched by other code.
+				finished = [ b for b in running if b.process.poll() is not None ]
+				if not finished :
+					time.sleep( 0.01 )
+					continue
+				
+				for batch in finished :
+					running.remove( batch )
+					if batch.process.returncode :
+						failed = True
+						IECore.msg( IECore.MessageHandler.Level.Error, messageContext, "Failed to execute " + batch.nodeName + " on frames " + batch.frameList() )
+					else :
+						batch.completed = True
+						if ledger is not None :
+							for task in batch.tasks :
+								ledger.record( task )
+						IECore.msg(
+							IECore.MessageHandler.Level.Info, messageContext,
+							"Executed %s on frames %s in %.2fs" % ( batch.nodeName, batch.frameList(), time.time() - batch.startTime )
+						)
+		
+		finally :
 			
-			IECore.msg( IECore.MessageHandler.Level.Info, messageContext, " ".join( cmd ) )
-			result = subprocess.call( cmd )
-			if result :
-				IECore.msg( IECore.MessageHandler.Level.Error, messageContext, "Failed to execute " + task.node().getName() + " on frames " + frames )
-				return
+			# If anything went wrong while dispatching, we must
+			# not leave orphaned processes running behind us.
+			for batch in running :
+				if batch.process.returncode is None :
+					batch.process.terminate()
+					batch.process.wait()
+		
+		if failed :
+			numSkipped = sum( len( b.frames ) for b in pending )
+			if numSkipped :
+				IECore.msg( IECore.MessageHandler.Level.Error, messageContext, "Skipped %d tasks due to earlier failures." % numSkipped )
+			return
 		
-		IECore.msg( IECore.MessageHandler.Level.Info, messageContext, "Completed all tasks." )
+		IECore.msg( IECore.MessageHandler.Level.Info, messageContext, "Completed all tasks in %.2fs." % ( time.time() - jobStartTime ) )
 	
 	def _doSetupPlugs( self, parentPlug ) :
 
 		pass
 	
+	## Groups the tasks into batches, each of which executes several frames
+	# of a single node in a single process. Batches are returned in an order
+	# where each follows all the batches it requires.
+	def __batches( self, script, taskDescriptions, maxWorkers ) :
+		
+		taskKeys = []
+		numFrames = {}
+		for ( task, requirements ) in taskDescriptions :
+			key = ( task.node().relativeName( script ), tuple( self.__contextArgs( task.context(), script ) ) )
+			taskKeys.append( key )
+			numFrames[key] = numFrames.get( key, 0 ) + 1
+		
+		framesPerBatch = self["framesPerBatch"].getValue()
+		
+		batches = []
+		taskBatches = {}
+		openBatches = {}
+		for ( task, requirements ), key in zip( taskDescriptions, taskKeys ) :
+			
+			requiredBatches = set( taskBatches[r] for r in requirements )
+			batchSize = framesPerBatch or ( numFrames[key] + maxWorkers - 1 ) // maxWorkers
+			
+			# A task may only join an existing batch if everything it requires
+			# is in an earlier batch. Because requirements always refer to earlier
+			# batches, the batches can never depend on one another cyclically.
+			batch = openBatches.get( key )
+			if batch is None or len( batch.frames ) >= batchSize or any( r.index >= batch.index for r in requiredBatches ) :
+				batch = _Batch( key[0], list( key[1] ), len( batches ) )
+				batches.append( batch )
+				openBatches[key] = batch
+			
+			batch.tasks.append( task )
+			batch.frames.append( int( task.context().getFrame() ) )
+			batch.requirements.update( requiredBatches )
+			taskBatches[task] = batch
+		
+		return batches
+	
+	@staticmethod
+	def __contextArgs( taskContext, script ) :
+		
+		contextArgs = []
+		for entry in taskContext.keys() :
+			if entry != "frame" and ( entry not in script.context().keys() or taskContext[entry] != script.context()[entry] ) :
+				contextArgs.extend( [ "-" + entry, repr(taskContext[entry]) ] )
+		
+		return contextArgs
+	
 	def __nextJobId( self, directory ) :
 		
 		previousJobs = IECore.ls( directory, minSequenceSize = 1 )
 		nextJob = max( previousJobs[0].frameList.asList() ) + 1 if previousJobs else 0
 		return nextJob
 
+## A group of frames of a single node, executed by a single process.
+class _Batch( object ) :
+	
+	def __init__( self, nodeName, contextArgs, index ) :
+		
+		self.nodeName = nodeName
+		self.contextArgs = contextArgs
+		self.index = index
+		self.tasks = []
+		self.frames = []
+		self.requirements = set()
+		self.process = None
+		self.startTime = None
+		self.completed = False
+	
+	def frameList( self ) :
+		
+		ranges = []
+		for frame in self.frames :
+			if ranges and frame == ranges[-1][1] + 1 :
+				ranges[-1][1] = frame
+			else :
+				ranges.append( [ frame, frame ] )
+		
+		return ",".join( str( r[0] ) if r[0] == r[1] else "%d-%d" % ( r[0], r[1] ) for r in ranges )
+	
+	def command( self, scriptFileName ) :
+		
+		cmd = [
+			"gaffer", "execute",
+			"-script", scriptFileName,
+			"-nodes", self.nodeName,
+			"-frames", self.frameList(),
+		]
+		
+		if self.contextArgs :
+			cmd.extend( [ "-context" ] + self.contextArgs )
+		
+		return cmd
+
 IECore.registerRunTimeTyped( LocalDispatcher, typeName = "Gaffer::LocalDispatcher" )
 
 Gaffer.Dispatcher.registerDispatcher( "Local", LocalDispatcher() )
@@ -45,8 +45,6 @@ class PythonExpressionEngine( Gaffer.Expression.Engine ) :
 	
 		Gaffer.Expression.Engine.__init__( self )
 		
-		self.__expression = expression
-		
 		parser = _Parser( expression )
 		if not parser.plugWrites :
 			raise Exception( "Expression does not write to a plug" )
@@ -56,6 +54,12 @@ class PythonExpressionEngine( Gaffer.Expression.Engine ) :
 		self.__inPlugs = parser.plugReads
 		self.__outPlug = parser.plugWrites[0]
 		self.__contextNames = parser.contextReads
+
+		# Compile the expression and split the plug paths once up front,
+		# rather than every time we're executed.
+		self.__code = compile( expression, "<expression>", "exec" )
+		self.__inPlugPaths = [ self.__splitPath( p ) for p in self.__inPlugs ]
+		self.__outPlugPath = self.__splitPath( self.__outPlug )
 	
 	def outPlug( self ) :
 	
@@ -72,23 +76,28 @@ class PythonExpressionEngine( Gaffer.Expression.Engine ) :
 	def execute( self, context, inputs, output ) :
 	
 		plugDict = {}
-		for plugPath, plug in zip( self.__inPlugs, inputs ) :
+		for ( parentNames, name ), plug in zip( self.__inPlugPaths, inputs ) :
 			parentDict = plugDict
-			plugPathSplit = plugPath.split( "." )
-			for p in plugPathSplit[:-1] :
+			for p in parentNames :
 				parentDict = parentDict.setdefault( p, {} )
-			parentDict[plugPathSplit[-1]] = plug.getValue()
+			parentDict[name] = plug.getValue()
 		
-		outputPlugPathSplit = self.__outPlug.split( "." )
+		outputParentNames, outputName = self.__outPlugPath
 		outputPlugDict = plugDict
-		for p in outputPlugPathSplit[:-1] :
+		for p in outputParentNames :
 			outputPlugDict = outputPlugDict.setdefault( p, {} )
 			
 		executionDict = { "parent" : plugDict, "context" : context }
 				
-		exec( self.__expression, executionDict, executionDict )
+		exec( self.__code, executionDict, executionDict )
 		
-		output.setValue( outputPlugDict[outputPlugPathSplit[-1]] )
+		output.setValue( outputPlugDict[outputName] )
+
+	@staticmethod
+	def __splitPath( plugPath ) :
+
+		s = plugPath.split( "." )
+		return ( s[:-1], s[-1] )
 	
 class _Parser( ast.NodeVisitor ) :
 
@@ -122,7 +131,7 @@ class _Parser( ast.NodeVisitor ) :
 			else :
 				contextName = self.__contextName( path )
 				if contextName :
-					self.contextReads.append( contextName )
+					self.__addContextRead( contextName )
 				
 	def visit_Call( self, node ) :
 			
@@ -131,14 +140,21 @@ class _Parser( ast.NodeVisitor ) :
 				if node.func.value.id == "context" :
 					# it's a method call on the context
 					if node.func.attr == "getFrame" :
-						self.contextReads.append( "frame" )
+						self.__addContextRead( "frame" )
 					elif node.func.attr == "get" :
 						if not isinstance( node.args[0], ast.Str ) :
 							raise SyntaxError( "Context name must be a string" )
-						self.contextReads.append( node.args[0].s )
+						self.__addContextRead( node.args[0].s )
 			
 		ast.NodeVisitor.generic_visit( self, node )
 					
+	def __addContextRead( self, name ) :
+
+		# The names are used to compute the hash for the
+		# expression, so there's no point listing them twice.
+		if name not in self.contextReads :
+			self.contextReads.append( name )
+
 	def __path( self, node ) :
 	
 		result = []
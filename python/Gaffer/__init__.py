@@ -45,9 +45,11 @@ from PathFilter import PathFilter
 from BlockedConnection import BlockedConnection
 from FileNamePathFilter import FileNamePathFilter
 from UndoContext import UndoContext
+from DirtyPropagationScope import DirtyPropagationScope
 from ObjectReader import ObjectReader
 from ObjectWriter import ObjectWriter
 from Context import Context
+from PerformanceMonitor import PerformanceMonitor
 from CompoundPathFilter import CompoundPathFilter
 from InfoPathFilter import InfoPathFilter
 from LazyModule import lazyImport, LazyModule
@@ -66,3 +68,5 @@ from ParameterPath import ParameterPath
 from OutputRedirection import OutputRedirection
 from LocalDispatcher import LocalDispatcher
 
+Dispatcher.registerDispatcher( "InProcess", InProcessDispatcher() )
+
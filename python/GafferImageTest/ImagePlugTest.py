@@ -35,6 +35,7 @@
 #  
 ##########################################################################
 
+import os
 import unittest
 
 import IECore
@@ -132,6 +133,80 @@ class ImagePlugTest( GafferTest.TestCase ) :
 		self.assertTrue( b.plugIsPromoted( b["n"]["in"] ) )
 		self.assertTrue( b.plugIsPromoted( b["n"]["out"] ) )
 
+	def testCacheEvictionPolicyPerformance( self ) :
+	
+		# A representative graph, with expensive resampling upstream of
+		# cheap colour corrections, evaluated repeatedly with a cache too
+		# small to hold every tile. CostAware should favour retaining the
+		# resampled tiles, so must miss less often than LeastRecentlyUsed,
+		# and must give identical results.
+		
+		s = Gaffer.ScriptNode()
+		
+		s["reader"] = GafferImage.ImageReader()
+		s["reader"]["fileName"].setValue( os.path.expandvars( "$GAFFER_ROOT/python/GafferTest/images/checkerWithNegativeDataWindow.200x150.exr" ) )
+		
+		s["reformat"] = GafferImage.Reformat()
+		s["reformat"]["in"].setInput( s["reader"]["out"] )
+		s["reformat"]["format"].setValue( GafferImage.Format( 1600, 1200, 1. ) )
+		s["reformat"]["filter"].setValue( "Lanczos" )
+		
+		s["grade1"] = GafferImage.Grade()
+		s["grade1"]["in"].setInput( s["reformat"]["out"] )
+		s["grade1"]["gain"].setValue( IECore.Color3f( 1.5 ) )
+		
+		s["grade2"] = GafferImage.Grade()
+		s["grade2"]["in"].setInput( s["grade1"]["out"] )
+		s["grade2"]["offset"].setValue( IECore.Color3f( 0.1 ) )
+		
+		with s.context() :
+			dataWindow = s["reformat"]["out"]["dataWindow"].getValue()
+			channelNames = s["reformat"]["out"]["channelNames"].getValue()
+		
+		tileSize = GafferImage.ImagePlug.tileSize()
+		numTiles = len( channelNames ) * ( ( dataWindow.size().x + tileSize ) / tileSize + 1 ) * ( ( dataWindow.size().y + tileSize ) / tileSize + 1 )
+		tileMemory = tileSize * tileSize * 4
+		
+		cacheMemoryLimit = Gaffer.ValuePlug.getCacheMemoryLimit()
+		cacheEvictionPolicy = Gaffer.ValuePlug.getCacheEvictionPolicy()
+		
+		def evaluate( policy ) :
+		
+			# Enough memory for the tiles of one node in the graph, but
+			# not all three.
+			Gaffer.ValuePlug.setCacheMemoryLimit( 0 )
+			Gaffer.ValuePlug.setCacheMemoryLimit( numTiles * tileMemory * 3 / 2 )
+			Gaffer.ValuePlug.setCacheEvictionPolicy( policy )
+			Gaffer.ValuePlug.resetCacheStatistics()
+			
+			with s.context() :
+				for i in range( 0, 3 ) :
+					image = s["grade2"]["out"].image()
+					s["grade1"]["out"].image()
+			
+			hits = 0
+			misses = 0
+			for i in range( 0, Gaffer.ValuePlug.numCacheShards() ) :
+				statistics = Gaffer.ValuePlug.cacheStatistics( i )
+				hits += statistics.hits
+				misses += statistics.misses
+			
+			return image, hits, misses
+		
+		try :
+			lruImage, lruHits, lruMisses = evaluate( Gaffer.ValuePlug.CacheEvictionPolicy.LeastRecentlyUsed )
+			costAwareImage, costAwareHits, costAwareMisses = evaluate( Gaffer.ValuePlug.CacheEvictionPolicy.CostAware )
+		finally :
+			Gaffer.ValuePlug.setCacheMemoryLimit( cacheMemoryLimit )
+			Gaffer.ValuePlug.setCacheEvictionPolicy( cacheEvictionPolicy )
+		
+		self.assertEqual( lruImage, costAwareImage )
+		self.assertLess( costAwareMisses, lruMisses )
+		self.assertGreater(
+			float( costAwareHits ) / ( costAwareHits + costAwareMisses ),
+			float( lruHits ) / ( lruHits + lruMisses )
+		)
+
 	def testTypeNamePrefixes( self ) :
 	
 		self.assertTypeNamesArePrefixed( GafferImage )
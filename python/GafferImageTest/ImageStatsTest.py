@@ -198,6 +198,55 @@ class ImageStatsTest( unittest.TestCase ) :
 		self.__assertColour( s["min"].getValue(), IECore.Color4f( 0.25, 0, 0, 0.5 ) )
 		self.__assertColour( s["max"].getValue(), IECore.Color4f( 0.5, 0.5, 0, 0.75 ) )
 
+	def testHistogram( self ) :
+
+		r = GafferImage.ImageReader()
+		r["fileName"].setValue( self.__rgbFilePath )
+
+		s = GafferImage.ImageStats()
+		s["in"].setInput( r["out"] )
+		s["channels"].setValue( IECore.StringVectorData( [ "R", "G", "B", "A" ] ) )
+		s["regionOfInterest"].setValue( r["out"]["format"].getValue().getDisplayWindow() )
+		s["histogramBins"].setValue( 8 )
+
+		histogram = s["histogram"].getValue()
+		self.assertEqual( set( histogram.keys() ), set( [ "R", "G", "B", "A" ] ) )
+		for channel in histogram.keys() :
+			self.assertEqual( len( histogram[channel] ), 8 )
+			self.assertEqual( sum( histogram[channel] ), 100 * 100 )
+
+		# Values outside the range should be counted in the end bins.
+		s["histogramRange"].setValue( IECore.V2f( 0.25, 0.5 ) )
+		histogram = s["histogram"].getValue()
+		for channel in histogram.keys() :
+			self.assertEqual( sum( histogram[channel] ), 100 * 100 )
+
+		# A region of interest outside the data window should be black.
+		s["regionOfInterest"].setValue( IECore.Box2i( IECore.V2i( 200 ), IECore.V2i( 209 ) ) )
+		histogram = s["histogram"].getValue()
+		self.assertEqual( histogram["R"][0], 100 )
+		self.__assertColour( s["max"].getValue(), IECore.Color4f( 0 ) )
+
+	def testPercentile( self ) :
+
+		r = GafferImage.ImageReader()
+		r["fileName"].setValue( self.__rgbFilePath )
+
+		s = GafferImage.ImageStats()
+		s["in"].setInput( r["out"] )
+		s["channels"].setValue( IECore.StringVectorData( [ "R", "G", "B", "A" ] ) )
+		s["regionOfInterest"].setValue( r["out"]["format"].getValue().getDisplayWindow() )
+
+		s["percentile"].setValue( 0 )
+		self.__assertColour( s["percentileValue"].getValue(), s["min"].getValue() )
+
+		s["percentile"].setValue( 100 )
+		self.__assertColour( s["percentileValue"].getValue(), s["max"].getValue() )
+
+		s["regionOfInterest"].setValue( IECore.Box2i( IECore.V2i( 20, 20 ), IECore.V2i( 24, 24 ) ) )
+		s["percentile"].setValue( 50 )
+		self.__assertColour( s["percentileValue"].getValue(), IECore.Color4f( 0.5, 0, 0, 0.5 ) )
+
 	def __assertColour( self, colour1, colour2 ) :
 		for i in range( 0, 4 ):
 			self.assertEqual( "%.4f" % colour2[i], "%.4f" % colour1[i] )
@@ -37,7 +37,9 @@
 import unittest
 
 import IECore
+import Gaffer
 import GafferImage
+import GafferImageTest
 import os
 
 class MergeTest( unittest.TestCase ) :
@@ -172,7 +174,49 @@ class MergeTest( unittest.TestCase ) :
 		expected = IECore.Reader.create( self.checkerRGBPath ).read()
 		
 		self.assertTrue( not IECore.ImageDiffOp()( imageA = expected, imageB = mergeResult, skipMissingChannels = False, maxError = 0.001 ).value )
-		
+	
+	def testKernels( self ) :
+	
+		GafferImageTest.testMergeKernels()
+	
+	def testManyInputs( self ) :
+	
+		s = Gaffer.ScriptNode()
+		s["merge"] = GafferImage.Merge()
+		s["merge"]["operation"].setValue( 8 ) # 8 is the Enum value of the over operation.
+		
+		reds = [ 0.1 + i * 0.01 for i in range( 0, 40 ) ]
+		for i, red in enumerate( reds ) :
+			s["c%d" % i] = GafferImage.Constant()
+			s["c%d" % i]["color"].setValue( IECore.Color4f( red, 0.2, 0.3, 0.5 ) )
+			s["merge"]["in" if i == 0 else "in%d" % i].setInput( s["c%d" % i]["out"] )
+		
+		# The last input is on top, and each earlier one is
+		# composited underneath it in turn.
+		expectedRed = reds[-1]
+		expectedAlpha = 0.5
+		for red in reversed( reds[:-1] ) :
+			expectedRed = expectedRed + red * ( 1 - expectedAlpha )
+			expectedAlpha = expectedAlpha + 0.5 * ( 1 - expectedAlpha )
+		
+		with s.context() :
+		
+			for v in s["merge"]["out"].channelData( "R", IECore.V2i( 0 ) ) :
+				self.assertAlmostEqual( v, expectedRed, 5 )
+			for v in s["merge"]["out"].channelData( "A", IECore.V2i( 0 ) ) :
+				self.assertAlmostEqual( v, expectedAlpha, 5 )
+			
+			# Disable the cache so that we time the merge itself
+			# rather than cache lookups.
+			cacheMemoryLimit = Gaffer.ValuePlug.getCacheMemoryLimit()
+			Gaffer.ValuePlug.setCacheMemoryLimit( 0 )
+			try :
+				t = IECore.Timer()
+				for i in range( 0, 200 ) :
+					s["merge"]["out"].channelData( "R", IECore.V2i( 0 ) )
+				# print t.stop()
+			finally :
+				Gaffer.ValuePlug.setCacheMemoryLimit( cacheMemoryLimit )
 
 if __name__ == "__main__":
 	unittest.main()
@@ -188,3 +188,52 @@ class ReformatTest( unittest.TestCase ) :
 		
 		self.assertEqual( r["out"]["channelNames"].hash(), c["out"]["channelNames"].hash() )
 		self.assertEqual( r["out"]["channelNames"].getValue(), c["out"]["channelNames"].getValue() )
+
+	def testChannelDataCachedInPool( self ) :
+	
+		c = GafferImage.Constant()
+		c["format"].setValue( GafferImage.Format( 100, 100, 1.0 ) )
+		
+		r = GafferImage.Reformat()
+		r["in"].setInput( c["out"] )
+		r["format"].setValue( GafferImage.Format( 200, 150, 1.0 ) )
+		
+		originalLimit = Gaffer.ValuePlug.getCachePoolMemoryLimit()
+		Gaffer.ValuePlug.setCachePoolMemoryLimit( 0 )
+		Gaffer.ValuePlug.setCachePoolMemoryLimit( originalLimit )
+		self.assertEqual( Gaffer.ValuePlug.cacheMemoryUsage( Gaffer.ValuePlug.CachePolicy.CachedInPool ), 0 )
+		
+		Gaffer.ValuePlug.resetCacheStatistics()
+		r["out"].image()
+		self.assertTrue( Gaffer.ValuePlug.cacheMemoryUsage( Gaffer.ValuePlug.CachePolicy.CachedInPool ) > 0 )
+		
+		misses = 0
+		for i in range( 0, Gaffer.ValuePlug.numCacheShards() ) :
+			misses += Gaffer.ValuePlug.cachePoolStatistics( i ).misses
+		self.assertTrue( misses > 0 )
+		self.assertRaises( Exception, Gaffer.ValuePlug.cachePoolStatistics, Gaffer.ValuePlug.numCacheShards() )
+
+	def testDownsize( self ) :
+	
+		c = GafferImage.Constant()
+		c["format"].setValue( GafferImage.Format( 4096, 2160, 1.0 ) )
+		c["color"].setValue( IECore.Color4f( 0.25, 0.5, 0.75, 1 ) )
+		
+		r = GafferImage.Reformat()
+		r["in"].setInput( c["out"] )
+		r["format"].setValue( GafferImage.Format( 1024, 540, 1.0 ) )
+		r["filter"].setValue( "Lanczos" )
+		
+		with Gaffer.Context() :
+			
+			dataWindow = r["out"]["dataWindow"].getValue()
+			t = IECore.Timer()
+			for y in range( GafferImage.ImagePlug.tileOrigin( dataWindow.min ).y, dataWindow.max.y + 1, GafferImage.ImagePlug.tileSize() ) :
+				for x in range( GafferImage.ImagePlug.tileOrigin( dataWindow.min ).x, dataWindow.max.x + 1, GafferImage.ImagePlug.tileSize() ) :
+					tile = r["out"].channelData( "G", IECore.V2i( x, y ) )
+			# print t.stop()
+		
+		# The weights are normalised, so resizing a constant
+		# image should leave the colour unchanged.
+		for v in tile :
+			self.assertAlmostEqual( v, 0.5, 5 )
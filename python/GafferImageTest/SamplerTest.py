@@ -194,6 +194,62 @@ class SamplerTest( unittest.TestCase ) :
 					self.__testHashOfBounds( sampleBox, "R", r["out"] )
 						
 
+	def testSampleRowAndBlock( self ) :
+
+		r = GafferImage.ImageReader()
+		r["fileName"].setValue( self.fileName )
+
+		bounds = r["out"]["dataWindow"].getValue()
+		f = GafferImage.Filter.create( "Box" )
+
+		c = Gaffer.Context()
+		c["image:channelName"] = "R"
+		c["image:tileOrigin"] = IECore.V2i( 0 )
+
+		with c :
+
+			for boundingMode in ( GafferImage.BoundingMode.Black, GafferImage.BoundingMode.Clamp ) :
+
+				s = GafferImage.Sampler( r["out"], "R", bounds, f, boundingMode )
+				s.prefetch()
+
+				# Rows which start and end outside the sample window, and
+				# which span several tiles.
+				for y in ( bounds.min.y - 2, bounds.min.y, bounds.min.y + 70, bounds.max.y, bounds.max.y + 2 ) :
+					x = bounds.min.x - 3
+					width = bounds.size().x + 7
+					row = s.sampleRow( x, y, width )
+					self.assertEqual( len( row ), width )
+					for i in range( 0, width ) :
+						self.assertEqual( row[i], s.sample( x + i, y ) )
+
+				region = IECore.Box2i( bounds.min - IECore.V2i( 2 ), bounds.min + IECore.V2i( 70 ) )
+				block = s.sampleBlock( region )
+				width = region.size().x + 1
+				for y in range( region.min.y, region.max.y + 1 ) :
+					for x in range( region.min.x, region.max.x + 1 ) :
+						self.assertEqual( block[(y-region.min.y)*width + x - region.min.x], s.sample( x, y ) )
+
+	def testSampleRowPerformance( self ) :
+
+		c = GafferImage.Constant()
+		c["format"].setValue( GafferImage.Format( 2048, 1556, 1. ) )
+
+		bounds = c["out"]["dataWindow"].getValue()
+		width = bounds.size().x + 1
+
+		with Gaffer.Context() :
+
+			s = GafferImage.Sampler( c["out"], "R", bounds )
+			s.prefetch()
+
+			t = IECore.Timer()
+			for y in range( bounds.min.y, bounds.max.y + 1 ) :
+				row = s.sampleRow( bounds.min.x, y, width )
+			# print t.stop()
+
+		self.assertEqual( len( row ), width )
+
 	# A private method that acumulates the hashes of the tiles within
 	# a box and compares them to the hash returned by the sampler.
 	def __testHashOfBounds( self, box, channel, plug ) :
@@ -186,6 +186,35 @@ class SceneNodeTest( GafferTest.TestCase ) :
 		for e in exceptions :
 			raise e
 	
+	def testTraverseScenePerformance( self ) :
+	
+		# Traversing many small locations is dominated by the cost of
+		# setting and getting scene:path in the Context, so this serves
+		# as a benchmark for the fast paths in Context.
+		
+		plane = GafferScene.Plane()
+		plane["divisions"].setValue( IECore.V2i( 100 ) )
+		
+		sphere = GafferScene.Sphere()
+		
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( plane["out"] )
+		instancer["instance"].setInput( sphere["out"] )
+		instancer["parent"].setValue( "/plane" )
+		
+		context = Gaffer.Context()
+		
+		t = IECore.Timer()
+		GafferSceneTest.traverseScene( instancer["out"], context )
+		# print "uncached", t.stop()
+		
+		t = IECore.Timer()
+		GafferSceneTest.traverseScene( instancer["out"], context )
+		# print "cached", t.stop()
+		
+		with context :
+			self.assertEqual( len( instancer["out"].childNames( "/plane/instances" ) ), 101 * 101 )
+	
 	def setUp( self ) :
 	
 		self.__previousCacheMemoryLimit = Gaffer.ValuePlug.getCacheMemoryLimit()
@@ -170,6 +170,77 @@ class SceneWriterTest( GafferSceneTest.SceneTestCase ) :
 		writer["in"].setInput( cube["out"] )
 		self.assertNotEqual( writer.executionHash( c ), current )
 	
+	def testMultipleFrames( self ) :
+		
+		script = Gaffer.ScriptNode()
+		script["sphere"] = GafferScene.Sphere()
+		script["expression"] = Gaffer.Expression()
+		script["expression"]["engine"].setValue( "python" )
+		script["expression"]["expression"].setValue( 'parent["sphere"]["transform"]["translate"]["x"] = context.getFrame()' )
+		
+		script["writer"] = GafferScene.SceneWriter()
+		script["writer"]["in"].setInput( script["sphere"]["out"] )
+		script["writer"]["fileName"].setValue( self.__testFile )
+		
+		contexts = []
+		for frame in range( 1, 5 ) :
+			contexts.append( Gaffer.Context( script.context() ) )
+			contexts[-1].setFrame( frame )
+		
+		script["writer"].execute( contexts )
+		
+		sc = IECore.SceneCache( self.__testFile, IECore.IndexedIO.OpenMode.Read )
+		sphere = sc.child( "sphere" )
+		for frame in range( 1, 5 ) :
+			self.assertEqual( sphere.readTransformAsMatrix( frame / 24.0 ), IECore.M44d.createTranslated( IECore.V3d( frame, 0, 0 ) ) )
+	
+	def testPerformance( self ) :
+		
+		# 100000 locations, written over several frames
+		
+		instanceInput = GafferSceneTest.CompoundObjectSource()
+		instanceInput["in"].setValue(
+			IECore.CompoundObject( {
+				"bound" : IECore.Box3fData( IECore.Box3f( IECore.V3f( -1 ), IECore.V3f( 1 ) ) ),
+			} )
+		)
+		
+		seeds = IECore.PointsPrimitive( IECore.V3fVectorData( [ IECore.V3f( i, 0, 0 ) for i in range( 0, 100000 ) ] ) )
+		seedsInput = GafferSceneTest.CompoundObjectSource()
+		seedsInput["in"].setValue(
+			IECore.CompoundObject( {
+				"bound" : IECore.Box3fData( seeds.bound() ),
+				"children" : {
+					"seeds" : {
+						"bound" : IECore.Box3fData( seeds.bound() ),
+						"object" : seeds,
+					},
+				},
+			} )
+		)
+		
+		script = Gaffer.ScriptNode()
+		script["instancer"] = GafferScene.Instancer()
+		script["instancer"]["in"].setInput( seedsInput["out"] )
+		script["instancer"]["instance"].setInput( instanceInput["out"] )
+		script["instancer"]["parent"].setValue( "/seeds" )
+		
+		script["writer"] = GafferScene.SceneWriter()
+		script["writer"]["in"].setInput( script["instancer"]["out"] )
+		script["writer"]["fileName"].setValue( self.__testFile )
+		
+		contexts = []
+		for frame in range( 1, 4 ) :
+			contexts.append( Gaffer.Context( script.context() ) )
+			contexts[-1].setFrame( frame )
+		
+		t = IECore.Timer()
+		script["writer"].execute( contexts )
+		#print "WRITE 100K LOCATIONS x 3 FRAMES", t.stop()
+		
+		sc = IECore.SceneCache( self.__testFile, IECore.IndexedIO.OpenMode.Read )
+		self.assertEqual( len( sc.child( "seeds" ).child( "instances" ).childNames() ), 100000 )
+	
 	def tearDown( self ) :
 		
 		if os.path.exists( self.__testFile ) :
@@ -174,6 +174,99 @@ class ComputeNodeTest( GafferTest.TestCase ) :
 		for t in threads :
 			t.join()
 			
+	def testConcurrentComputationsAreShared( self ) :
+	
+		class SlowNode( Gaffer.ComputeNode ) :
+		
+			def __init__( self, name="SlowNode" ) :
+		
+				Gaffer.ComputeNode.__init__( self, name )
+		
+				self["in"] = Gaffer.IntPlug()
+				self["out"] = Gaffer.IntPlug( direction = Gaffer.Plug.Direction.Out )
+				
+				self.numComputations = 0
+				
+			def affects( self, input ) :
+					
+				if input.isSame( self["in"] ) :
+					return [ self["out"] ]
+				
+				return []
+		
+			def hash( self, output, context, h ) :
+			
+				self["in"].hash( h )
+		
+			def compute( self, plug, context ) :
+		
+				self.numComputations += 1
+				time.sleep( 0.5 )
+				plug.setValue( self["in"].getValue() * 2 )
+
+		IECore.registerRunTimeTyped( SlowNode )
+		
+		n = SlowNode()
+		n["in"].setValue( 10 )
+		
+		results = []
+		def f() :
+			results.append( n["out"].getValue() )
+		
+		threads = []
+		for i in range( 0, 10 ) :
+			t = threading.Thread( target = f )
+			t.start()
+			threads.append( t )
+			
+		for t in threads :
+			t.join()
+		
+		self.assertEqual( results, [ 20 ] * 10 )
+		self.assertEqual( n.numComputations, 1 )
+		
+	def testSharedComputationsWithPythonExpressions( self ) :
+	
+		# Python expressions need the GIL to compute, so this would deadlock
+		# if a thread waiting for a shared computation held onto the GIL.
+	
+		s = Gaffer.ScriptNode()
+		s["n"] = Gaffer.Node()
+		s["n"]["s"] = Gaffer.StringPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["n"]["o"] = Gaffer.ObjectPlug( "o", defaultValue = IECore.NullObject(), flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		
+		s["e1"] = Gaffer.Expression()
+		s["e1"]["engine"].setValue( "python" )
+		s["e1"]["expression"].setValue( "import time; time.sleep( 0.01 ); parent[\"n\"][\"s\"] = \"x\" * int( context[\"frame\"] )" )
+		
+		s["e2"] = Gaffer.Expression()
+		s["e2"]["engine"].setValue( "python" )
+		s["e2"]["expression"].setValue( "import IECore; parent[\"n\"][\"o\"] = IECore.StringVectorData( [ parent[\"n\"][\"s\"] ] * 10 )" )
+		
+		results = {}
+		def f( frame, plugName ) :
+			c = Gaffer.Context( s.context() )
+			c.setFrame( frame )
+			with c :
+				results[(frame,plugName)] = s["n"][plugName].getValue()
+		
+		threads = []
+		for i in range( 0, 40 ) :
+			frame = 1 + i % 4
+			plugName = "o" if i % 3 else "s"
+			t = threading.Thread( target = f, args = ( frame, plugName ) )
+			t.start()
+			threads.append( t )
+			
+		for t in threads :
+			t.join()
+		
+		for ( frame, plugName ), value in results.items() :
+			if plugName == "s" :
+				self.assertEqual( value, "x" * frame )
+			else :
+				self.assertEqual( value, IECore.StringVectorData( [ "x" * frame ] * 10 ) )
+		
 	def testDirtyNotPropagatedDuringCompute( self ) :
 					
 		n1 = GafferTest.AddNode( "n1" )
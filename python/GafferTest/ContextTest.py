@@ -275,6 +275,14 @@ class ContextTest( GafferTest.TestCase ) :
 	
 		GafferTest.testManyContexts()
 
+	def testEditableScope( self ) :
+	
+		GafferTest.testEditableScope()
+		
+	def testManyEditableScopes( self ) :
+	
+		GafferTest.testManyEditableScopes()
+
 	def testGetWithAndWithoutCopying( self ) :
 	
 		c = Gaffer.Context()
@@ -417,6 +425,84 @@ class ContextTest( GafferTest.TestCase ) :
 		c2["testIntVector"] = IECore.IntVectorData( [ 20 ] )
 		
 		self.assertEqual( c1.get( "testIntVector", _copy=False ).refCount(), r )
+	
+	def testHash( self ) :
+	
+		c1 = Gaffer.Context()
+		c1["a"] = 10
+		c1["b"] = "b"
+		
+		# the order in which values are set doesn't matter
+		c2 = Gaffer.Context()
+		c2["b"] = "b"
+		c2["a"] = 10
+		self.assertEqual( c1.hash(), c2.hash() )
+		
+		# but the values and names do
+		c2["a"] = 11
+		self.assertNotEqual( c1.hash(), c2.hash() )
+		c2["a"] = 10
+		self.assertEqual( c1.hash(), c2.hash() )
+		
+		c2["c"] = 10
+		self.assertNotEqual( c1.hash(), c2.hash() )
+		
+		c3 = Gaffer.Context()
+		c3["a"] = "b"
+		c3["b"] = 10
+		self.assertNotEqual( c1.hash(), c3.hash() )
+		
+		# copies hash the same, however they were made
+		for ownership in Gaffer.Context.Ownership.values.values() :
+			c4 = Gaffer.Context( c1, ownership )
+			self.assertEqual( c4.hash(), c1.hash() )
+			c4["a"] = 20
+			self.assertNotEqual( c4.hash(), c1.hash() )
+	
+	def testFrequentlyUsedVariables( self ) :
+	
+		# these variables are given special treatment internally,
+		# but should behave exactly as any other.
+	
+		c = Gaffer.Context()
+		
+		c["image:channelName"] = "R"
+		c["image:tileOrigin"] = IECore.V2i( 0 )
+		c["scene:path"] = IECore.InternedStringVectorData( [ "a", "b" ] )
+		
+		self.assertEqual( c["image:channelName"], "R" )
+		self.assertEqual( c["image:tileOrigin"], IECore.V2i( 0 ) )
+		self.assertEqual( c["scene:path"], IECore.InternedStringVectorData( [ "a", "b" ] ) )
+		self.assertEqual( set( c.names() ), set( [ "frame", "image:channelName", "image:tileOrigin", "scene:path" ] ) )
+		
+		# values we have references to mustn't be modified
+		# by subsequent calls to set().
+		
+		path = c.get( "scene:path", _copy = False )
+		c["scene:path"] = IECore.InternedStringVectorData( [ "c" ] )
+		self.assertEqual( c["scene:path"], IECore.InternedStringVectorData( [ "c" ] ) )
+		self.assertEqual( path, IECore.InternedStringVectorData( [ "a", "b" ] ) )
+		
+		c["image:channelName"] = "G"
+		c.setFrame( 10 )
+		
+		# and copies must be independent
+		
+		for ownership in ( Gaffer.Context.Ownership.Copied, Gaffer.Context.Ownership.Shared ) :
+			cc = Gaffer.Context( c, ownership )
+			self.assertEqual( cc, c )
+			self.assertEqual( cc.hash(), c.hash() )
+			cc["image:channelName"] = "B"
+			cc.setFrame( 20 )
+			self.assertEqual( c["image:channelName"], "G" )
+			self.assertEqual( c.getFrame(), 10 )
+			self.assertEqual( cc["image:channelName"], "B" )
+			self.assertEqual( cc.getFrame(), 20 )
+		
+		# the type of a variable can still be changed
+		
+		c["frame"] = "notAFloat"
+		self.assertEqual( c["frame"], "notAFloat" )
 		
 if __name__ == "__main__":
 	unittest.main()
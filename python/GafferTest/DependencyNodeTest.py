@@ -319,6 +319,106 @@ class DependencyNodeTest( GafferTest.TestCase ) :
 		self.assertTrue( cs[2][0].isSame( n["o"]["y"] ) )
 		self.assertTrue( cs[3][0].isSame( n["o"]["z"] ) )
 		self.assertTrue( cs[4][0].isSame( n["o"] ) )
-		
+
+	def testDirtyPropagationScope( self ) :
+
+		n1 = GafferTest.AddNode()
+		n2 = GafferTest.AddNode()
+		n2["op1"].setInput( n1["sum"] )
+
+		cs1 = GafferTest.CapturingSlot( n1.plugDirtiedSignal() )
+		cs2 = GafferTest.CapturingSlot( n2.plugDirtiedSignal() )
+
+		with Gaffer.DirtyPropagationScope() :
+
+			n1["op1"].setValue( 1 )
+			n1["op2"].setValue( 2 )
+
+			with Gaffer.DirtyPropagationScope() :
+				n1["op1"].setValue( 3 )
+
+			self.assertEqual( len( cs1 ), 0 )
+			self.assertEqual( len( cs2 ), 0 )
+
+		self.assertEqual( len( cs1 ), 3 )
+		self.assertTrue( cs1[0][0].isSame( n1["op1"] ) )
+		self.assertTrue( cs1[1][0].isSame( n1["op2"] ) )
+		self.assertTrue( cs1[2][0].isSame( n1["sum"] ) )
+
+		self.assertEqual( len( cs2 ), 2 )
+		self.assertTrue( cs2[0][0].isSame( n2["op1"] ) )
+		self.assertTrue( cs2[1][0].isSame( n2["sum"] ) )
+
+		self.assertEqual( n2["sum"].getValue(), 5 )
+
+	def testValuesWithinDirtyPropagationScope( self ) :
+
+		n1 = GafferTest.AddNode()
+		n2 = GafferTest.AddNode()
+		n2["op1"].setInput( n1["sum"] )
+
+		self.assertEqual( n2["sum"].getValue(), 0 )
+
+		cs = GafferTest.CapturingSlot( n2.plugDirtiedSignal() )
+		with Gaffer.DirtyPropagationScope() :
+
+			n1["op1"].setValue( 1 )
+			self.assertEqual( n2["sum"].getValue(), 1 )
+
+			n1["op2"].setValue( 2 )
+			self.assertEqual( n2["sum"].getValue(), 3 )
+
+			self.assertEqual( len( cs ), 0 )
+
+		self.assertEqual( len( cs ), 2 )
+		self.assertEqual( n2["sum"].getValue(), 3 )
+
+	def testDirtyPropagationScopeWithRemovedPlugs( self ) :
+
+		n = GafferTest.AddNode()
+		n["dynamic"] = Gaffer.IntPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+
+		cs = GafferTest.CapturingSlot( n.plugDirtiedSignal() )
+
+		with Gaffer.DirtyPropagationScope() :
+			n["dynamic"].setValue( 1 )
+			n.removeChild( n["dynamic"] )
+
+		self.assertEqual( len( cs ), 0 )
+
+	def testAffectsTablesFollowStructureChanges( self ) :
+
+		class DynamicOutputsNode( Gaffer.DependencyNode ) :
+
+			def __init__( self, name = "DynamicOutputsNode" ) :
+
+				Gaffer.DependencyNode.__init__( self, name )
+
+				self["in"] = Gaffer.IntPlug()
+				self["out"] = Gaffer.CompoundPlug( direction = Gaffer.Plug.Direction.Out )
+
+			def affects( self, input ) :
+
+				outputs = Gaffer.DependencyNode.affects( self, input )
+				if input.isSame( self["in"] ) :
+					outputs.extend( self["out"].children() )
+
+				return outputs
+
+		n1 = GafferTest.AddNode()
+		n2 = DynamicOutputsNode()
+		n2["in"].setInput( n1["sum"] )
+		n2["out"]["a"] = Gaffer.IntPlug( direction = Gaffer.Plug.Direction.Out )
+
+		cs = GafferTest.CapturingSlot( n2.plugDirtiedSignal() )
+		n1["op1"].setValue( 1 )
+		self.assertEqual( [ x[0].relativeName( n2 ) for x in cs ], [ "in", "out.a", "out" ] )
+
+		n2["out"]["b"] = Gaffer.IntPlug( direction = Gaffer.Plug.Direction.Out )
+
+		del cs[:]
+		n1["op1"].setValue( 2 )
+		self.assertEqual( [ x[0].relativeName( n2 ) for x in cs ], [ "in", "out.a", "out.b", "out" ] )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -0,0 +1,123 @@
+##########################################################################
+#  
+#  Copyright (c) 2014, Image Engine Design Inc. All rights reserved.
+#  
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#  
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#  
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#  
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#  
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#  
+##########################################################################
+
+import os
+import shutil
+import unittest
+
+import Gaffer
+import GafferTest
+
+class ExecutionLedgerTest( GafferTest.TestCase ) :
+	
+	__fileName = "/tmp/executionLedgerTest/ledger.txt"
+	
+	def setUp( self ) :
+		
+		GafferTest.TestCase.setUp( self )
+		
+		os.makedirs( "/tmp/executionLedgerTest" )
+	
+	def testRecord( self ) :
+		
+		s = Gaffer.ScriptNode()
+		s["w"] = GafferTest.TextWriter()
+		s["w"]["fileName"].setValue( "/tmp/executionLedgerTest/w_####.txt" )
+		s["w"]["text"].setValue( "w on ${frame}" )
+		
+		task = Gaffer.ExecutableNode.Task( s["w"], s.context() )
+		
+		ledger = Gaffer.ExecutionLedger( self.__fileName )
+		self.assertEqual( ledger.fileName(), self.__fileName )
+		self.assertFalse( ledger.executed( task ) )
+		
+		s["w"].execute( [ s.context() ] )
+		ledger.record( task )
+		self.assertTrue( ledger.executed( task ) )
+		
+		# Records should persist.
+		
+		ledger = Gaffer.ExecutionLedger( self.__fileName )
+		self.assertTrue( ledger.executed( task ) )
+		
+		# But only while the hash is unchanged.
+		
+		s["w"]["text"].setValue( "w again on ${frame}" )
+		self.assertFalse( ledger.executed( Gaffer.ExecutableNode.Task( s["w"], s.context() ) ) )
+		
+		# And the outputs are intact.
+		
+		os.remove( s.context().substitute( s["w"]["fileName"].getValue() ) )
+		self.assertFalse( ledger.executed( task ) )
+	
+	def testIncompleteHashesAreIgnored( self ) :
+		
+		class IncompleteTextWriter( GafferTest.TextWriter ) :
+			
+			def __init__( self, name = "IncompleteTextWriter" ) :
+				
+				GafferTest.TextWriter.__init__( self, name )
+			
+			def executionHashIsComplete( self ) :
+				
+				return False
+		
+		s = Gaffer.ScriptNode()
+		s["w"] = IncompleteTextWriter()
+		s["w"]["fileName"].setValue( "/tmp/executionLedgerTest/w_####.txt" )
+		s["w"]["text"].setValue( "w on ${frame}" )
+		
+		self.assertFalse( s["w"].executionHashIsComplete() )
+		self.assertTrue( GafferTest.TextWriter().executionHashIsComplete() )
+		# Nodes must opt in to having complete hashes.
+		self.assertFalse( Gaffer.ExecutableOpHolder().executionHashIsComplete() )
+		
+		task = Gaffer.ExecutableNode.Task( s["w"], s.context() )
+		
+		s["w"].execute( [ s.context() ] )
+		ledger = Gaffer.ExecutionLedger( self.__fileName )
+		ledger.record( task )
+		self.assertFalse( ledger.executed( task ) )
+		self.assertFalse( os.path.exists( self.__fileName ) )
+	
+	def tearDown( self ) :
+		
+		GafferTest.TestCase.tearDown( self )
+		
+		shutil.rmtree( "/tmp/executionLedgerTest", ignore_errors = True )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -37,6 +37,8 @@
 
 import unittest
 
+import IECore
+
 import Gaffer
 import GafferTest
 
@@ -254,6 +256,222 @@ class ExpressionTest( GafferTest.TestCase ) :
 		s["e"]["expression"].setValue( "parent['n']['op2'] = context.get( 'iDontExist', 101 )" )
 		
 		self.assertEqual( s["n"]["sum"].getValue(), 101 )
-		
+
+	def testArithmeticEngine( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["m1"] = GafferTest.MultiplyNode()
+		s["m1"]["op1"].setValue( 10 )
+		s["m1"]["op2"].setValue( 20 )
+
+		s["m2"] = GafferTest.MultiplyNode()
+		s["m2"]["op2"].setValue( 1 )
+
+		s["e"] = Gaffer.Expression()
+		s["e"]["engine"].setValue( "arithmetic" )
+		s["e"]["expression"].setValue( "parent[\"m2\"][\"op1\"] = parent[\"m1\"][\"product\"] * 2" )
+
+		self.assertTrue( "arithmetic" in Gaffer.Expression.Engine.registeredEngines() )
+		self.assertTrue( s["m2"]["op1"].getInput().isSame( s["e"]["out"] ) )
+		self.assertEqual( s["m2"]["product"].getValue(), 400 )
+
+	def testArithmeticEngineOperators( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["n"] = Gaffer.Node()
+		s["n"]["a"] = Gaffer.FloatPlug()
+		s["n"]["b"] = Gaffer.IntPlug()
+		s["n"]["c"] = Gaffer.BoolPlug()
+		s["n"]["out"] = Gaffer.FloatPlug()
+
+		s["n"]["a"].setValue( 7.5 )
+		s["n"]["b"].setValue( -2 )
+		s["n"]["c"].setValue( True )
+
+		s["e"] = Gaffer.Expression()
+		s["e"]["engine"].setValue( "arithmetic" )
+
+		# we expect the same results as python, except that division
+		# is always floating point.
+		plugs = { "a" : "parent['n']['a']", "b" : "parent['n']['b']", "c" : "parent['n']['c']" }
+		values = { "a" : "7.5", "b" : "(-2)", "c" : "True" }
+		for expression in [
+			"{a} + {b} * 2",
+			"( {a} + {b} ) * 2",
+			"{a} / {b}",
+			"{a} // {b}",
+			"{a} % {b}",
+			"-{a} % 4",
+			"{b} ** 2",
+			"2 ** -1",
+			"-{b} ** 2",
+			"{a} > {b}",
+			"{a} <= {b}",
+			"{a} == 7.5 and {b} != 1",
+			"0 or {b}",
+			"0 and {b}",
+			"not {c}",
+			"{a} if {c} else {b}",
+			"{a} if not {c} else {b}",
+			"abs( {b} )",
+			"min( {a}, {b}, 3 )",
+			"max( {a}, {b}, 3 )",
+			"pow( 2, 3 )",
+			"round( 2.5 )",
+			"round( -2.5 )",
+			"int( -{a} )",
+			"float( {b} )",
+			"bool( 0.5 )",
+			"1e3 + .5",
+			"True + False",
+		] :
+			s["e"]["expression"].setValue( "parent['n']['out'] = " + expression.format( **plugs ) )
+			self.assertAlmostEqual( s["n"]["out"].getValue(), float( eval( expression.format( **values ) ) ), 5, expression )
+
+	def testArithmeticEngineContextAccess( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["n"] = Gaffer.Node()
+		s["n"]["out"] = Gaffer.FloatPlug()
+
+		s["e"] = Gaffer.Expression()
+		s["e"]["engine"].setValue( "arithmetic" )
+		s["e"]["expression"].setValue( "parent['n']['out'] = context['frame'] + context.getFrame() + context.get( 'a', 10 ) + context.get( 'b' )" )
+
+		with Gaffer.Context() as c :
+
+			c.setFrame( 2 )
+			c["b"] = 1
+			self.assertEqual( s["n"]["out"].getValue(), 15 )
+
+			c["a"] = 20
+			self.assertEqual( s["n"]["out"].getValue(), 25 )
+
+			c["b"] = True
+			c.setFrame( 3 )
+			self.assertEqual( s["n"]["out"].getValue(), 27 )
+
+			c["b"] = "iAmAString"
+			self.assertRaises( RuntimeError, s["n"]["out"].getValue )
+
+	def testArithmeticEngineErrors( self ) :
+
+		for expression in [
+			"parent['n']['out'] = ",
+			"parent['n']['out'] = 1 +",
+			"parent['n']['out'] = ( 1",
+			"parent['n']['out'] = 1 2",
+			"parent['n']['out'] = sin( 1 )",
+			"parent['n']['out'] = min( 1 )",
+			"parent['n']['out'] = 'a'",
+			"parent['n']['out'] = 1 if 2",
+			"parent['n']['out'] = context[1]",
+			"parent['n']['out'] = 1; parent['n']['out'] = 2",
+			"context['a'] = 1",
+			"1",
+		] :
+			self.assertRaises( RuntimeError, Gaffer.Expression.Engine.create, "arithmetic", expression )
+
+		s = Gaffer.ScriptNode()
+		s["n"] = Gaffer.Node()
+		s["n"]["out"] = Gaffer.FloatPlug()
+		s["e"] = Gaffer.Expression()
+		s["e"]["engine"].setValue( "arithmetic" )
+		s["e"]["expression"].setValue( "parent['n']['out'] = 1 / context['frame']" )
+
+		with Gaffer.Context() as c :
+			c.setFrame( 0 )
+			self.assertRaises( RuntimeError, s["n"]["out"].getValue )
+
+	def testArithmeticEngineIntegerConversion( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = Gaffer.Node()
+		s["n"]["out"] = Gaffer.IntPlug()
+		s["e"] = Gaffer.Expression()
+		s["e"]["engine"].setValue( "arithmetic" )
+
+		# Unlike python, "/" is always true division, so "//"
+		# must be used to get integer division.
+		for expression, value in [
+			( "7 / 2", 3 ),
+			( "-7 / 2", -3 ),
+			( "7 // 2", 3 ),
+			( "-7 // 2", -4 ),
+			( "-7 % 2", 1 ),
+		] :
+			s["e"]["expression"].setValue( "parent['n']['out'] = " + expression )
+			self.assertEqual( s["n"]["out"].getValue(), value )
+
+		for expression in [
+			"10 ** 400",
+			"-( 10 ** 400 )",
+			"10 ** 400 - 10 ** 400",
+			"2 ** 31",
+			"context['frame'] * 1e10",
+		] :
+			s["e"]["expression"].setValue( "parent['n']['out'] = " + expression )
+			self.assertRaises( RuntimeError, s["n"]["out"].getValue )
+
+	def testArithmeticEngineParallelPerformance( self ) :
+
+		results = {}
+		for engine in ( "python", "arithmetic" ) :
+
+			s = Gaffer.ScriptNode()
+
+			s["m"] = GafferTest.MultiplyNode()
+			s["m"]["op2"].setValue( 2 )
+
+			s["e"] = Gaffer.Expression()
+			s["e"]["engine"].setValue( engine )
+			s["e"]["expression"].setValue( "parent['m']['op1'] = int( int( context.getFrame() * 2 + 1 ) % 7 - abs( context.getFrame() ) // 3 )" )
+
+			t = IECore.Timer()
+			GafferTest.parallelGetValue( s["m"]["product"], 20000 )
+			# print engine, t.stop()
+
+			results[engine] = []
+			with Gaffer.Context() as c :
+				for frame in range( -20, 20 ) :
+					c.setFrame( frame + 0.5 )
+					results[engine].append( s["m"]["product"].getValue() )
+
+		self.assertEqual( results["arithmetic"], results["python"] )
+
+	def testIrrelevantContextVariablesDontCauseExecution( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["n"] = GafferTest.AddNode()
+
+		s["e"] = Gaffer.Expression()
+		s["e"]["engine"].setValue( "python" )
+		s["e"]["expression"].setValue( "parent['n']['op1'] = int( context.getFrame() + context['frame'] + context.get( 'a', 1 ) )" )
+
+		def hash( frame, a, b ) :
+
+			with Gaffer.Context() as c :
+				c.setFrame( frame )
+				c["a"] = a
+				c["b"] = b
+				return s["e"]["out"].hash()
+
+		self.assertEqual( hash( 1, 1, 1 ), hash( 1, 1, 2 ) )
+		self.assertNotEqual( hash( 1, 1, 1 ), hash( 2, 1, 1 ) )
+		self.assertNotEqual( hash( 1, 1, 1 ), hash( 1, 2, 1 ) )
+
+		with Gaffer.PerformanceMonitor() as m :
+			with Gaffer.Context() as c :
+				c.setFrame( 10 )
+				for b in range( 0, 10 ) :
+					c["b"] = b
+					self.assertEqual( s["n"]["sum"].getValue(), 21 )
+
+		self.assertEqual( m.plugStatistics( s["e"]["out"] ).computeCount, 1 )
+
 if __name__ == "__main__":
 	unittest.main()
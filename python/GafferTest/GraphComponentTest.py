@@ -668,7 +668,104 @@ class GraphComponentTest( GafferTest.TestCase ) :
 		p.clearChildren()
 		
 		self.assertEqual( len( p ), 0 )
-		
+	
+	def testRenameToExistingSiblingName( self ) :
+
+		# Check both small and large numbers of children, as different
+		# code paths are used for each.
+		for numChildren in ( 2, 100 ) :
+
+			g = Gaffer.GraphComponent()
+			for i in range( 0, numChildren ) :
+				g.addChild( Gaffer.GraphComponent( "c" ) )
+
+			self.assertEqual( g[-1].getName(), "c%d" % ( numChildren - 1 ) )
+
+			self.assertEqual( g[-1].setName( "c" ), "c%d" % ( numChildren - 1 ) )
+			self.assertEqual( g[0].setName( "c1" ), "c%d" % numChildren )
+			self.assertEqual( g[0].setName( "c" ), "c" )
+
+			self.assertEqual( len( set( c.getName() for c in g ) ), numChildren )
+			for c in g :
+				self.assertTrue( g[c.getName()].isSame( c ) )
+
+	def testNamingWithManyChildren( self ) :
+
+		g = Gaffer.GraphComponent()
+		for i in range( 0, 100 ) :
+			g.addChild( Gaffer.GraphComponent( "a" ) )
+		g.addChild( Gaffer.GraphComponent( "a1somethingElse" ) )
+		g.addChild( Gaffer.GraphComponent( "b5" ) )
+		g.addChild( Gaffer.GraphComponent( "b5" ) )
+
+		self.assertEqual( g[0].getName(), "a" )
+		self.assertEqual( g[99].getName(), "a99" )
+		self.assertEqual( g[100].getName(), "a1somethingElse" )
+		self.assertEqual( g[101].getName(), "b5" )
+		self.assertEqual( g[102].getName(), "b6" )
+
+		# Renaming should make names available for reuse, and
+		# should free the old name.
+
+		a99 = g["a99"]
+		a99.setName( "z" )
+		self.assertTrue( g["z"].isSame( a99 ) )
+		self.assertTrue( "a99" not in g )
+		g.addChild( Gaffer.GraphComponent( "a" ) )
+		self.assertEqual( g[-1].getName(), "a99" )
+
+		# As should removing children.
+
+		g.removeChild( g["a99"] )
+		g.removeChild( g["a98"] )
+		self.assertTrue( "a98" not in g )
+		g.addChild( Gaffer.GraphComponent( "a" ) )
+		self.assertEqual( g[-1].getName(), "a98" )
+
+		# Removing a child shouldn't affect the lookup of another
+		# child that happens to share its name.
+
+		h = Gaffer.GraphComponent()
+		h.addChild( g["a50"] )
+		g.addChild( Gaffer.GraphComponent( "a50" ) )
+		self.assertEqual( g[-1].getName(), "a50" )
+		self.assertTrue( g["a50"].isSame( g[-1] ) )
+
+		# Undo should keep everything consistent too.
+
+		s = Gaffer.ScriptNode()
+		for i in range( 0, 100 ) :
+			s.addChild( Gaffer.Node( "n" ) )
+
+		with Gaffer.UndoContext( s ) :
+			s["n10"].setName( "renamed" )
+			s.removeChild( s["n20"] )
+
+		self.assertTrue( "n10" not in s )
+		self.assertTrue( "n20" not in s )
+
+		s.undo()
+		self.assertTrue( "renamed" not in s )
+		self.assertEqual( s["n10"].getName(), "n10" )
+		self.assertEqual( s["n20"].getName(), "n20" )
+
+		s.redo()
+		self.assertTrue( "n10" not in s )
+		self.assertEqual( s["renamed"].getName(), "renamed" )
+
+	def testNamingPerformance( self ) :
+
+		g = Gaffer.GraphComponent()
+
+		t = IECore.Timer()
+		for i in range( 0, 20000 ) :
+			g.addChild( Gaffer.GraphComponent() )
+		for i in range( 1, 20000 ) :
+			g["GraphComponent%d" % i]
+		# print t.stop()
+
+		self.assertEqual( g[-1].getName(), "GraphComponent19999" )
+
 if __name__ == "__main__":
 	unittest.main()
 	
@@ -0,0 +1,214 @@
+##########################################################################
+#  
+#  Copyright (c) 2014, Image Engine Design Inc. All rights reserved.
+#  
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#  
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#  
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#  
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#  
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#  
+##########################################################################
+
+import os
+import shutil
+import unittest
+import threading
+
+import IECore
+
+import Gaffer
+import GafferTest
+
+class InProcessDispatcherTest( GafferTest.TestCase ) :
+	
+	class __RecordingNode( Gaffer.ExecutableNode ) :
+		
+		def __init__( self, log, name = "RecordingNode" ) :
+			
+			Gaffer.ExecutableNode.__init__( self, name )
+			
+			self.__log = log
+			self.__lock = threading.Lock()
+		
+		def execute( self, contexts ) :
+			
+			with self.__lock :
+				self.__log.append( ( self.getName(), [ int( c.getFrame() ) for c in contexts ] ) )
+		
+		def executionHash( self, context ) :
+			
+			h = Gaffer.ExecutableNode.executionHash( self, context )
+			h.append( self.getName() )
+			h.append( context.getFrame() )
+			
+			return h
+	
+	def setUp( self ) :
+		
+		GafferTest.TestCase.setUp( self )
+		
+		os.makedirs( "/tmp/dispatcherTest" )
+	
+	def testDispatcherRegistration( self ) :
+		
+		self.failUnless( "InProcess" in Gaffer.Dispatcher.dispatcherNames() )
+		self.failUnless( Gaffer.Dispatcher.dispatcher( "InProcess" ).isInstanceOf( Gaffer.InProcessDispatcher.staticTypeId() ) )
+	
+	def testDispatch( self ) :
+		
+		dispatcher = Gaffer.InProcessDispatcher()
+		dispatcher["framesMode"].setValue( Gaffer.Dispatcher.FramesMode.CustomRange )
+		dispatcher["frameRange"].setValue( "1-4" )
+		
+		s = Gaffer.ScriptNode()
+		for name in ( "n1", "n2", "n2a", "n2b" ) :
+			s[name] = GafferTest.TextWriter()
+			s[name]["fileName"].setValue( "/tmp/dispatcherTest/%s_####.txt" % name )
+			s[name]["text"].setValue( name + " on ${frame}" )
+		
+		s["n1"]["requirements"][0].setInput( s["n2"]["requirement"] )
+		s["n2"]["requirements"][0].setInput( s["n2a"]["requirement"] )
+		s["n2"]["requirements"][1].setInput( s["n2b"]["requirement"] )
+		
+		dispatcher.dispatch( [ s["n1"] ] )
+		
+		context = Gaffer.Context( s.context() )
+		for frame in range( 1, 5 ) :
+			context.setFrame( frame )
+			for name in ( "n1", "n2", "n2a", "n2b" ) :
+				with file( context.substitute( s[name]["fileName"].getValue() ), "r" ) as f :
+					self.assertEqual( f.read(), "%s on %d" % ( name, frame ) )
+	
+	def testRequirementsAndBatching( self ) :
+		
+		dispatcher = Gaffer.InProcessDispatcher()
+		dispatcher["framesMode"].setValue( Gaffer.Dispatcher.FramesMode.CustomRange )
+		dispatcher["frameRange"].setValue( "1-6" )
+		dispatcher["framesPerBatch"].setValue( 3 )
+		
+		log = []
+		s = Gaffer.ScriptNode()
+		s["n1"] = self.__RecordingNode( log )
+		s["n2"] = self.__RecordingNode( log )
+		s["n3"] = self.__RecordingNode( log )
+		s["n1"]["requirements"][0].setInput( s["n2"]["requirement"] )
+		s["n1"]["requirements"][1].setInput( s["n3"]["requirement"] )
+		
+		dispatcher.dispatch( [ s["n1"] ] )
+		
+		self.assertEqual( len( log ), 6 )
+		for name in ( "n1", "n2", "n3" ) :
+			self.assertEqual( [ l[1] for l in log if l[0] == name ], [ [ 1, 2, 3 ], [ 4, 5, 6 ] ] )
+
+		for frames in ( [ 1, 2, 3 ], [ 4, 5, 6 ] ) :
+			n1Index = log.index( ( "n1", frames ) )
+			self.assertGreater( n1Index, log.index( ( "n2", frames ) ) )
+			self.assertGreater( n1Index, log.index( ( "n3", frames ) ) )
+	
+	def testFailureOnlyAffectsDependents( self ) :
+		
+		dispatcher = Gaffer.InProcessDispatcher()
+		
+		s = Gaffer.ScriptNode()
+		for name in ( "n1", "n2", "n3" ) :
+			s[name] = GafferTest.TextWriter()
+			s[name]["fileName"].setValue( "/tmp/dispatcherTest/%s_####.txt" % name )
+			s[name]["text"].setValue( name + " on ${frame}" )
+		
+		s["n2"]["fileName"].setValue( "/dev/null/n2_####.txt" )
+		s["n1"]["requirements"][0].setInput( s["n2"]["requirement"] )
+		
+		with IECore.CapturingMessageHandler() as mh :
+			self.assertRaises( RuntimeError, dispatcher.dispatch, [ s["n1"], s["n3"] ] )
+		
+		self.assertEqual( len( [ m for m in mh.messages if m.level == IECore.Msg.Level.Error ] ), 1 )
+		self.assertFalse( os.path.isfile( s.context().substitute( s["n1"]["fileName"].getValue() ) ) )
+		self.assertTrue( os.path.isfile( s.context().substitute( s["n3"]["fileName"].getValue() ) ) )
+	
+	def testExecutionLedger( self ) :
+		
+		dispatcher = Gaffer.InProcessDispatcher()
+		dispatcher["executionLedger"].setValue( "/tmp/dispatcherTest/ledger.txt" )
+		
+		s = Gaffer.ScriptNode()
+		for name in ( "n1", "n2" ) :
+			s[name] = GafferTest.TextWriter()
+			s[name]["fileName"].setValue( "/tmp/dispatcherTest/%s_####.txt" % name )
+			s[name]["text"].setValue( name + " on ${frame}" )
+		s["n1"]["requirements"][0].setInput( s["n2"]["requirement"] )
+		
+		fileNames = dict( ( name, s.context().substitute( s[name]["fileName"].getValue() ) ) for name in ( "n1", "n2" ) )
+		
+		def read( name ) :
+			with file( fileNames[name] ) as f :
+				return f.read()
+		
+		# Replaces the contents of an output without changing
+		# its modification time, so we can detect reexecution.
+		def tamper( name ) :
+			st = os.stat( fileNames[name] )
+			with file( fileNames[name], "w" ) as f :
+				f.write( "tampered" )
+			os.utime( fileNames[name], ( st.st_atime, st.st_mtime ) )
+		
+		dispatcher.dispatch( [ s["n1"] ] )
+		self.assertEqual( read( "n1" ), "n1 on 1" )
+		self.assertEqual( read( "n2" ), "n2 on 1" )
+		
+		# Nothing has changed, so nothing should be executed.
+		
+		tamper( "n1" )
+		tamper( "n2" )
+		dispatcher.dispatch( [ s["n1"] ] )
+		self.assertEqual( read( "n1" ), "tampered" )
+		self.assertEqual( read( "n2" ), "tampered" )
+		
+		# Removing an output should cause only that task to be executed again.
+		
+		os.remove( fileNames["n1"] )
+		dispatcher.dispatch( [ s["n1"] ] )
+		self.assertEqual( read( "n1" ), "n1 on 1" )
+		self.assertEqual( read( "n2" ), "tampered" )
+		
+		# Changing the hash of a requirement should cause it and
+		# everything downstream to be executed again.
+		
+		tamper( "n1" )
+		s["n2"]["text"].setValue( "n2 modified on ${frame}" )
+		dispatcher.dispatch( [ s["n1"] ] )
+		self.assertEqual( read( "n1" ), "n1 on 1" )
+		self.assertEqual( read( "n2" ), "n2 modified on 1" )
+	
+	def tearDown( self ) :
+		
+		GafferTest.TestCase.tearDown( self )
+		
+		shutil.rmtree( "/tmp/dispatcherTest", ignore_errors = True )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -382,6 +382,60 @@ class LocalDispatcherTest( GafferTest.TestCase ) :
 		self.assertTrue( os.path.exists( jobDir ) )
 		shutil.rmtree( jobDir )
 	
+	def testBatching( self ) :
+		
+		dispatcher = Gaffer.LocalDispatcher()
+		dispatcher["jobDirectory"].setValue( "/tmp/dispatcherTest" )
+		dispatcher["framesMode"].setValue( Gaffer.Dispatcher.FramesMode.CustomRange )
+		dispatcher["frameRange"].setValue( "1-4" )
+		dispatcher["maxWorkers"].setValue( 2 )
+		dispatcher["framesPerBatch"].setValue( 2 )
+		
+		s = Gaffer.ScriptNode()
+		for name in ( "n1", "n2" ) :
+			s[name] = GafferTest.TextWriter()
+			s[name]["fileName"].setValue( "/tmp/dispatcherTest/%s_####.txt" % name )
+			s[name]["text"].setValue( name + " on ${frame}" )
+		s["n1"]["requirements"][0].setInput( s["n2"]["requirement"] )
+		
+		with IECore.CapturingMessageHandler() as mh :
+			dispatcher.dispatch( [ s["n1"] ] )
+		
+		commands = [ m.message for m in mh.messages if m.message.startswith( "gaffer execute" ) ]
+		self.assertEqual( len( commands ), 4 )
+		for name in ( "n1", "n2" ) :
+			for frames in ( "1-2", "3-4" ) :
+				self.assertEqual( len( [ c for c in commands if "-nodes %s -frames %s" % ( name, frames ) in c ] ), 1 )
+		
+		self.assertEqual( len( [ m for m in mh.messages if m.message.startswith( "Executed" ) ] ), 4 )
+		
+		context = Gaffer.Context( s.context() )
+		for frame in range( 1, 5 ) :
+			context.setFrame( frame )
+			for name in ( "n1", "n2" ) :
+				with file( context.substitute( s[name]["fileName"].getValue() ), "r" ) as f :
+					self.assertEqual( f.read(), "%s on %d" % ( name, frame ) )
+	
+	def testFailedRequirementPreventsExecution( self ) :
+		
+		dispatcher = Gaffer.LocalDispatcher()
+		dispatcher["jobDirectory"].setValue( "/tmp/dispatcherTest" )
+		dispatcher["framesMode"].setValue( Gaffer.Dispatcher.FramesMode.CurrentFrame )
+		
+		s = Gaffer.ScriptNode()
+		s["n1"] = GafferTest.TextWriter()
+		s["n1"]["fileName"].setValue( "/tmp/dispatcherTest/n1_####.txt" )
+		s["n1"]["text"].setValue( "n1 on ${frame}" )
+		s["n2"] = GafferTest.TextWriter()
+		s["n2"]["fileName"].setValue( "/dev/null/n2_####.txt" )
+		s["n1"]["requirements"][0].setInput( s["n2"]["requirement"] )
+		
+		with IECore.CapturingMessageHandler() as mh :
+			dispatcher.dispatch( [ s["n1"] ] )
+		
+		self.assertFalse( os.path.isfile( s.context().substitute( s["n1"]["fileName"].getValue() ) ) )
+		self.assertTrue( any( m.level == IECore.Msg.Level.Error for m in mh.messages ) )
+	
 	def tearDown( self ) :
 		
 		shutil.rmtree( "/tmp/dispatcherTest", ignore_errors = True )
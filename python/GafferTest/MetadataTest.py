@@ -376,6 +376,36 @@ class MetadataTest( GafferTest.TestCase ) :
 	
 		GafferTest.testMetadataThreading()
 		
+	def testPlugValueFollowsRenamedPlug( self ) :
+
+		n = GafferTest.AddNode()
+		self.assertEqual( Gaffer.Metadata.plugValue( n["op1"], "renameTest" ), None )
+
+		Gaffer.Metadata.registerPlugValue( GafferTest.AddNode, "renamed", "renameTest", "x" )
+		self.assertEqual( Gaffer.Metadata.plugValue( n["op1"], "renameTest" ), None )
+
+		n["op1"].setName( "renamed" )
+		self.assertEqual( Gaffer.Metadata.plugValue( n["renamed"], "renameTest" ), "x" )
+
+		n["renamed"].setName( "op1" )
+		self.assertEqual( Gaffer.Metadata.plugValue( n["op1"], "renameTest" ), None )
+
+	def testPlugValuePerformance( self ) :
+
+		for i in range( 0, 100 ) :
+			Gaffer.Metadata.registerPlugValue( self.DerivedAddNode, "performanceTest%d*" % i, "performanceTest", i )
+
+		n = self.DerivedAddNode()
+
+		t = IECore.Timer()
+		for i in range( 0, 10000 ) :
+			Gaffer.Metadata.plugValue( n["op1"], "performanceTest" )
+			Gaffer.Metadata.plugValue( n["sum"], "description" )
+		# print t.stop()
+
+		self.assertEqual( Gaffer.Metadata.plugValue( n["op1"], "performanceTest" ), None )
+
+
 if __name__ == "__main__":
 	unittest.main()
 
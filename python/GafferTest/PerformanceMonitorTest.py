@@ -0,0 +1,192 @@
+##########################################################################
+#  
+#  Copyright (c) 2014, Image Engine Design Inc. All rights reserved.
+#  
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#  
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#  
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#  
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#  
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#  
+##########################################################################
+
+import os
+import json
+import unittest
+
+import IECore
+
+import Gaffer
+import GafferTest
+
+class PerformanceMonitorTest( GafferTest.TestCase ) :
+
+	def testStatistics( self ) :
+
+		n1 = GafferTest.AddNode()
+		n1["op1"].setValue( 1003 )
+		n2 = GafferTest.AddNode()
+		n2["op1"].setInput( n1["sum"] )
+		n2["op2"].setValue( 2007 )
+
+		with Gaffer.PerformanceMonitor() as m :
+			n2["sum"].getValue()
+
+		s1 = m.plugStatistics( n1["sum"] )
+		s2 = m.plugStatistics( n2["sum"] )
+
+		self.assertEqual( s1.hashCount, 1 )
+		self.assertEqual( s1.computeCount, 1 )
+		self.assertEqual( s2.hashCount, 1 )
+		self.assertEqual( s2.computeCount, 1 )
+
+		self.assertTrue( s2.totalComputeTime >= s2.exclusiveComputeTime )
+		self.assertTrue( s2.totalComputeTime >= s1.totalComputeTime )
+
+		self.assertEqual( m.plugStatistics( n1["op1"] ), Gaffer.PerformanceMonitor.Statistics() )
+
+		c = m.combinedStatistics()
+		self.assertEqual( c.hashCount, s1.hashCount + s2.hashCount )
+		self.assertEqual( c.computeCount, s1.computeCount + s2.computeCount )
+
+		a = m.allStatistics()
+		self.assertEqual( len( a ), 2 )
+		for plug, statistics in a.items() :
+			self.assertTrue( plug.isSame( n1["sum"] ) or plug.isSame( n2["sum"] ) )
+			self.assertEqual( statistics, m.plugStatistics( plug ) )
+
+	def testCacheHits( self ) :
+
+		n = GafferTest.AddNode()
+		n["op1"].setValue( 3001 )
+
+		with Gaffer.PerformanceMonitor() as m :
+			n["sum"].getValue()
+			Gaffer.ValuePlug.clearHashCache()
+			n["sum"].getValue()
+
+		s = m.plugStatistics( n["sum"] )
+		self.assertEqual( s.computeCount, 1 )
+		self.assertEqual( s.cacheHitCount, 1 )
+		self.assertEqual( s.hashCount, 2 )
+
+	def testInactive( self ) :
+
+		m = Gaffer.PerformanceMonitor()
+
+		n = GafferTest.AddNode()
+		n["op1"].setValue( 4001 )
+		n["sum"].getValue()
+
+		with m :
+			pass
+
+		self.assertEqual( m.combinedStatistics(), Gaffer.PerformanceMonitor.Statistics() )
+		self.assertEqual( m.allStatistics(), {} )
+
+	def testNesting( self ) :
+
+		n = GafferTest.AddNode()
+		n["op1"].setValue( 5001 )
+
+		with Gaffer.PerformanceMonitor() as m1 :
+			with Gaffer.PerformanceMonitor() as m2 :
+				n["sum"].getValue()
+			n["op1"].setValue( 5002 )
+			n["sum"].getValue()
+
+		self.assertEqual( m1.plugStatistics( n["sum"] ).computeCount, 1 )
+		self.assertEqual( m2.plugStatistics( n["sum"] ).computeCount, 1 )
+
+	def testOutOfOrderScopes( self ) :
+
+		n = GafferTest.AddNode()
+		n["op1"].setValue( 5501 )
+
+		m1 = Gaffer.PerformanceMonitor()
+		m2 = Gaffer.PerformanceMonitor()
+
+		s1 = Gaffer.PerformanceMonitor._Scope( m1 )
+		s2 = Gaffer.PerformanceMonitor._Scope( m2 )
+
+		# Destroying the outer scope first must not
+		# deactivate the monitor of the inner one.
+		del s1
+		n["sum"].getValue()
+		self.assertEqual( m1.plugStatistics( n["sum"] ).computeCount, 0 )
+		self.assertEqual( m2.plugStatistics( n["sum"] ).computeCount, 1 )
+
+		# And destroying the inner one must not
+		# reactivate the monitor of the outer one.
+		del s2
+		n["op1"].setValue( 5502 )
+		n["sum"].getValue()
+		self.assertEqual( m1.plugStatistics( n["sum"] ).computeCount, 0 )
+		self.assertEqual( m2.plugStatistics( n["sum"] ).computeCount, 1 )
+
+	def testScopeKeepsMonitorAlive( self ) :
+
+		n = GafferTest.AddNode()
+		n["op1"].setValue( 5601 )
+
+		s = Gaffer.PerformanceMonitor._Scope( Gaffer.PerformanceMonitor() )
+		n["sum"].getValue()
+		del s
+
+	def testChromeTrace( self ) :
+
+		n1 = GafferTest.AddNode()
+		n1["op1"].setValue( 6001 )
+		n2 = GafferTest.AddNode()
+		n2["op1"].setInput( n1["sum"] )
+
+		with Gaffer.PerformanceMonitor( recordEvents = True ) as m :
+			n2["sum"].getValue()
+
+		m.writeChromeTrace( self.__traceFileName )
+
+		with open( self.__traceFileName ) as f :
+			trace = json.load( f )
+
+		events = trace["traceEvents"]
+		self.assertEqual( len( events ), 2 )
+		self.assertEqual( set( e["name"] for e in events ), set( [ n1["sum"].fullName(), n2["sum"].fullName() ] ) )
+		for e in events :
+			self.assertEqual( e["ph"], "X" )
+			self.assertTrue( e["dur"] >= 0 )
+
+	def tearDown( self ) :
+
+		GafferTest.TestCase.tearDown( self )
+
+		if os.path.exists( self.__traceFileName ) :
+			os.remove( self.__traceFileName )
+
+	__traceFileName = "/tmp/performanceMonitorTrace.json"
+
+if __name__ == "__main__":
+	unittest.main()
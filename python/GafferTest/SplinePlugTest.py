@@ -508,6 +508,10 @@ class SplinePlugTest( GafferTest.TestCase ) :
 	
 		p = Gaffer.SplineffPlug()
 		p.getValue()
+	
+	def testLUT( self ) :
+	
+		GafferTest.testSplineLUT()
 		
 if __name__ == "__main__":
 	unittest.main()
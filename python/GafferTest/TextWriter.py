@@ -70,5 +70,14 @@ class TextWriter( Gaffer.ExecutableNode ) :
 		h.append( context.substitute( self["text"].getValue() ) )
 		
 		return h
+	
+	def executionOutputs( self, context ) :
+		
+		with context :
+			return [ context.substitute( self["fileName"].getValue() ) ]
+	
+	def executionHashIsComplete( self ) :
+		
+		return True
 
 IECore.registerRunTimeTyped( TextWriter, typeName = "GafferTest::TextWriter" )
@@ -35,6 +35,8 @@
 #  
 ##########################################################################
 
+import time
+
 import IECore
 
 import Gaffer
@@ -232,13 +234,225 @@ class ValuePlugTest( GafferTest.TestCase ) :
 		
 		self.assertTrue( "[\"f\"].setValue" in s.serialise() )
 		
+	def testCacheStatistics( self ) :
+	
+		def totals() :
+		
+			result = { "hits" : 0, "misses" : 0, "evictions" : 0, "memoryUsage" : 0 }
+			for i in range( 0, Gaffer.ValuePlug.numCacheShards() ) :
+				s = Gaffer.ValuePlug.cacheStatistics( i )
+				for k in result.keys() :
+					result[k] += getattr( s, k )
+			
+			return result
+		
+		self.assertTrue( Gaffer.ValuePlug.numCacheShards() > 0 )
+		self.assertRaises( Exception, Gaffer.ValuePlug.cacheStatistics, Gaffer.ValuePlug.numCacheShards() )
+			
+		n = GafferTest.CachingTestNode()
+		n["in"].setValue( "statistics" )
+		
+		Gaffer.ValuePlug.resetCacheStatistics()
+		
+		n["out"].getValue( _copy = False )
+		self.assertEqual( totals()["misses"], 1 )
+		self.assertEqual( totals()["hits"], 0 )
+		
+		n["out"].getValue( _copy = False )
+		self.assertEqual( totals()["misses"], 1 )
+		self.assertEqual( totals()["hits"], 1 )
+		
+		self.assertEqual( totals()["memoryUsage"], Gaffer.ValuePlug.cacheMemoryUsage() )
+		
+		Gaffer.ValuePlug.setCacheMemoryLimit( 0 )
+		self.assertTrue( totals()["evictions"] > 0 )
+		self.assertEqual( totals()["memoryUsage"], 0 )
+		
+	def testCacheValuesLargerThanShard( self ) :
+	
+		limit = 1024 * 1024
+		Gaffer.ValuePlug.setCacheMemoryLimit( 0 )
+		Gaffer.ValuePlug.setCacheMemoryLimit( limit )
+		
+		n = GafferTest.CachingTestNode()
+		n["in"].setValue( "x" * ( limit / 4 ) )
+		
+		v1 = n["out"].getValue( _copy = False )
+		self.assertTrue( v1.memoryUsage() > limit / Gaffer.ValuePlug.numCacheShards() )
+		self.assertTrue( Gaffer.ValuePlug.cacheMemoryUsage() >= v1.memoryUsage() )
+		
+		v2 = n["out"].getValue( _copy = False )
+		self.assertTrue( v1.isSame( v2 ) )
+		
+		# Filling the cache should evict entries from any shard,
+		# keeping the total within the limit.
+		
+		for i in range( 0, 20 ) :
+			n["in"].setValue( str( i ) * ( limit / 4 ) )
+			n["out"].getValue( _copy = False )
+			self.assertTrue( Gaffer.ValuePlug.cacheMemoryUsage() <= limit )
+		
+		self.assertTrue( Gaffer.ValuePlug.cacheMemoryUsage() > limit / 2 )
+		
+	def testCostAwareCacheEvictionPolicy( self ) :
+	
+		class CostNode( Gaffer.ComputeNode ) :
+		
+			def __init__( self, name="CostNode" ) :
+			
+				Gaffer.ComputeNode.__init__( self, name )
+				
+				self["out"] = Gaffer.ObjectPlug( direction = Gaffer.Plug.Direction.Out, defaultValue = IECore.NullObject() )
+				
+				self.expensiveComputations = 0
+				
+			def affects( self, input ) :
+			
+				return []
+				
+			def hash( self, output, context, h ) :
+			
+				h.append( context["costTest:key"] )
+				
+			def compute( self, plug, context ) :
+			
+				key = context["costTest:key"]
+				if key % 10 == 0 :
+					# One in ten values is expensive to compute. The sleep
+					# is long enough that the measured compute times can't
+					# be confused with those of the cheap values, even on a
+					# heavily loaded machine.
+					self.expensiveComputations += 1
+					time.sleep( 0.01 )
+				
+				plug.setValue( IECore.StringData( str( key ).ljust( 1000 ) ), _copy = False )
+				
+		IECore.registerRunTimeTyped( CostNode )
+		
+		def expensiveComputations( policy ) :
+		
+			n = CostNode()
+			
+			# a cache large enough to hold all the expensive values,
+			# but only a quarter of the total working set.
+			c = Gaffer.Context()
+			c["costTest:key"] = 0
+			with c :
+				valueSize = n["out"].getValue( _copy = False ).memoryUsage()
+			
+			Gaffer.ValuePlug.setCacheMemoryLimit( 0 )
+			Gaffer.ValuePlug.setCacheMemoryLimit( valueSize * 50 )
+			Gaffer.ValuePlug.setCacheEvictionPolicy( policy )
+			n.expensiveComputations = 0
+			
+			# cyclic access is the worst case for LeastRecentlyUsed,
+			# which evicts everything before it is used again.
+			for i in range( 0, 5 ) :
+				for key in range( 0, 200 ) :
+					c["costTest:key"] = key
+					with c :
+						n["out"].getValue( _copy = False )
+						
+			return n.expensiveComputations
+		
+		# LeastRecentlyUsed depends only on the order of access, so
+		# cyclic access means every single value is recomputed.
+		lru = expensiveComputations( Gaffer.ValuePlug.CacheEvictionPolicy.LeastRecentlyUsed )
+		self.assertEqual( lru, 100 )
+		
+		# CostAware should retain all the expensive values after the
+		# first pass. Because eviction chooses the lowest priority entry
+		# across all shards, this doesn't depend on how the values happen
+		# to be distributed between them.
+		costAware = expensiveComputations( Gaffer.ValuePlug.CacheEvictionPolicy.CostAware )
+		self.assertEqual( costAware, 20 )
+	
+	def testHashCache( self ) :
+	
+		n = GafferTest.AddNode()
+		n["op1"].setValue( 1 )
+		
+		Gaffer.ValuePlug.clearHashCache()
+		self.assertEqual( Gaffer.ValuePlug.hashCacheHits(), 0 )
+		self.assertEqual( Gaffer.ValuePlug.hashCacheMisses(), 0 )
+		
+		h1 = n["sum"].hash()
+		self.assertEqual( Gaffer.ValuePlug.hashCacheMisses(), 1 )
+		self.assertTrue( Gaffer.ValuePlug.hashCacheMemoryUsage() > 0 )
+		
+		h2 = n["sum"].hash()
+		self.assertEqual( h1, h2 )
+		self.assertEqual( Gaffer.ValuePlug.hashCacheHits(), 1 )
+		
+		# entries are per context
+		
+		with Gaffer.Context() as c :
+			c["test"] = 10
+			n["sum"].hash()
+			
+		self.assertEqual( Gaffer.ValuePlug.hashCacheMisses(), 2 )
+		
+		# and are invalidated by dirtiness
+		
+		n["op1"].setValue( 2 )
+		h3 = n["sum"].hash()
+		self.assertNotEqual( h3, h1 )
+		self.assertEqual( Gaffer.ValuePlug.hashCacheMisses(), 3 )
+		self.assertEqual( n["sum"].getValue(), 2 )
+		
+		# including dirtiness propagated from upstream
+		
+		n2 = GafferTest.AddNode()
+		n["op2"].setInput( n2["sum"] )
+		h4 = n["sum"].hash()
+		self.assertNotEqual( h4, h3 )
+		
+		n2["op1"].setValue( 10 )
+		self.assertNotEqual( n["sum"].hash(), h4 )
+		self.assertEqual( n["sum"].getValue(), 12 )
+	
+	def testHashCacheMemoryLimit( self ) :
+	
+		n = GafferTest.AddNode()
+		
+		Gaffer.ValuePlug.setHashCacheMemoryLimit( 0 )
+		Gaffer.ValuePlug.clearHashCache()
+		
+		h1 = n["sum"].hash()
+		h2 = n["sum"].hash()
+		self.assertEqual( h1, h2 )
+		
+		self.assertEqual( Gaffer.ValuePlug.hashCacheHits(), 0 )
+		self.assertEqual( Gaffer.ValuePlug.hashCacheMemoryUsage(), 0 )
+	
+	def testCachePolicySettings( self ) :
+	
+		Gaffer.ValuePlug.setCachePoolMemoryLimit( 1024 * 1024 )
+		self.assertEqual( Gaffer.ValuePlug.getCachePoolMemoryLimit(), 1024 * 1024 )
+		
+		Gaffer.ValuePlug.setCacheComputeTimeThreshold( 1000 )
+		self.assertEqual( Gaffer.ValuePlug.getCacheComputeTimeThreshold(), 1000 )
+		
+		Gaffer.ValuePlug.setCacheMemoryLimit( 0 )
+		Gaffer.ValuePlug.setCachePoolMemoryLimit( 0 )
+		for policy in Gaffer.ValuePlug.CachePolicy.values.values() :
+			self.assertEqual( Gaffer.ValuePlug.cacheMemoryUsage( policy ), 0 )
+		
 	def setUp( self ) :
 	
 		self.__originalCacheMemoryLimit = Gaffer.ValuePlug.getCacheMemoryLimit()
+		self.__originalCachePoolMemoryLimit = Gaffer.ValuePlug.getCachePoolMemoryLimit()
+		self.__originalCacheComputeTimeThreshold = Gaffer.ValuePlug.getCacheComputeTimeThreshold()
+		self.__originalHashCacheMemoryLimit = Gaffer.ValuePlug.getHashCacheMemoryLimit()
+		self.__originalCacheEvictionPolicy = Gaffer.ValuePlug.getCacheEvictionPolicy()
 		
 	def tearDown( self ) :
 	
 		Gaffer.ValuePlug.setCacheMemoryLimit( self.__originalCacheMemoryLimit )
+		Gaffer.ValuePlug.setCachePoolMemoryLimit( self.__originalCachePoolMemoryLimit )
+		Gaffer.ValuePlug.setCacheComputeTimeThreshold( self.__originalCacheComputeTimeThreshold )
+		Gaffer.ValuePlug.setHashCacheMemoryLimit( self.__originalHashCacheMemoryLimit )
+		Gaffer.ValuePlug.setCacheEvictionPolicy( self.__originalCacheEvictionPolicy )
 		
 if __name__ == "__main__":
 	unittest.main()
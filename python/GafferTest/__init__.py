@@ -122,6 +122,8 @@ from ExecutableOpHolderTest import ExecutableOpHolderTest
 from DispatcherTest import DispatcherTest
 from TextWriter import TextWriter
 from LocalDispatcherTest import LocalDispatcherTest
+from InProcessDispatcherTest import InProcessDispatcherTest
+from ExecutionLedgerTest import ExecutionLedgerTest
 from RecursiveChildIteratorTest import RecursiveChildIteratorTest
 from FilteredRecursiveChildIteratorTest import FilteredRecursiveChildIteratorTest
 from ReferenceTest import ReferenceTest
@@ -135,6 +137,7 @@ from SerialisationTest import SerialisationTest
 from SwitchTest import SwitchTest
 from MetadataTest import MetadataTest
 from StringAlgoTest import StringAlgoTest
+from PerformanceMonitorTest import PerformanceMonitorTest
 
 if __name__ == "__main__":
 	import unittest
@@ -0,0 +1,953 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2014, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <cctype>
+#include <cstring>
+#include <algorithm>
+#include <limits>
+
+#include "boost/format.hpp"
+#include "boost/lexical_cast.hpp"
+#include "boost/shared_ptr.hpp"
+
+#include "IECore/SimpleTypedData.h"
+
+#include "Gaffer/ArithmeticExpressionEngine.h"
+#include "Gaffer/NumericPlug.h"
+#include "Gaffer/TypedPlug.h"
+#include "Gaffer/Context.h"
+
+using namespace IECore;
+using namespace Gaffer;
+
+//////////////////////////////////////////////////////////////////////////
+// Parser. This is a simple recursive descent parser for the subset of
+// the python grammar we support. It builds a syntax tree which is then
+// compiled into a program for the stack machine.
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// The maximum depth of the stack used to execute a program. This
+// is generous for any expression a person might reasonably write,
+// and allows us to keep the stack on the C++ stack during execution.
+const size_t g_maxStackSize = 64;
+
+} // namespace
+
+class ArithmeticExpressionEngine::Parser
+{
+
+	public :
+
+		Parser( const std::string &expression, ArithmeticExpressionEngine *engine )
+			:	m_expression( expression ), m_position( 0 ), m_engine( engine )
+		{
+			nextToken();
+
+			m_engine->m_outPlug = plugPath();
+			expect( "=" );
+			SyntaxNodePtr value = test();
+			if( m_token.type != EndToken )
+			{
+				error( "Unexpected \"" + m_token.text + "\"" );
+			}
+
+			m_engine->m_stackSize = compile( value.get() );
+			if( m_engine->m_stackSize > g_maxStackSize )
+			{
+				throw IECore::Exception( "Expression is too complex" );
+			}
+		}
+
+	private :
+
+		//////////////////////////////////////////////////////////////////
+		// Tokenising
+		//////////////////////////////////////////////////////////////////
+
+		enum TokenType
+		{
+			NumberToken,
+			StringToken,
+			NameToken,
+			OperatorToken,
+			EndToken
+		};
+
+		struct Token
+		{
+			TokenType type;
+			std::string text;
+			size_t position;
+		};
+
+		void nextToken()
+		{
+			const std::string &e = m_expression;
+			size_t &i = m_position;
+
+			// skip whitespace and comments
+			while( i < e.size() )
+			{
+				if( isspace( e[i] ) )
+				{
+					i++;
+				}
+				else if( e[i] == '#' )
+				{
+					while( i < e.size() && e[i] != '\n' )
+					{
+						i++;
+					}
+				}
+				else
+				{
+					break;
+				}
+			}
+
+			m_token.position = i;
+			m_token.text.clear();
+			if( i >= e.size() )
+			{
+				m_token.type = EndToken;
+				return;
+			}
+
+			const char c = e[i];
+			if( isdigit( c ) || ( c == '.' && i + 1 < e.size() && isdigit( e[i+1] ) ) )
+			{
+				m_token.type = NumberToken;
+				while( i < e.size() && ( isdigit( e[i] ) || e[i] == '.' ) )
+				{
+					m_token.text += e[i++];
+				}
+				if( i < e.size() && ( e[i] == 'e' || e[i] == 'E' ) )
+				{
+					m_token.text += e[i++];
+					if( i < e.size() && ( e[i] == '+' || e[i] == '-' ) )
+					{
+						m_token.text += e[i++];
+					}
+					while( i < e.size() && isdigit( e[i] ) )
+					{
+						m_token.text += e[i++];
+					}
+				}
+			}
+			else if( isalpha( c ) || c == '_' )
+			{
+				m_token.type = NameToken;
+				while( i < e.size() && ( isalnum( e[i] ) || e[i] == '_' ) )
+				{
+					m_token.text += e[i++];
+				}
+			}
+			else if( c == '"' || c == '\'' )
+			{
+				m_token.type = StringToken;
+				i++;
+				while( i < e.size() && e[i] != c )
+				{
+					if( e[i] == '\\' || e[i] == '\n' )
+					{
+						error( "Unsupported character in string" );
+					}
+					m_token.text += e[i++];
+				}
+				if( i >= e.size() )
+				{
+					error( "Unterminated string" );
+				}
+				i++;
+			}
+			else
+			{
+				m_token.type = OperatorToken;
+				static const char *twoCharacterOperators[] = { "**", "//", "<=", ">=", "==", "!=", 0 };
+				for( const char **o = twoCharacterOperators; *o; ++o )
+				{
+					if( e.compare( i, 2, *o ) == 0 )
+					{
+						m_token.text = *o;
+						i += 2;
+						return;
+					}
+				}
+				if( !strchr( "+-*/%<>=()[],.", c ) )
+				{
+					error( std::string( "Unexpected character \"" ) + c + "\"" );
+				}
+				m_token.text = c;
+				i++;
+			}
+		}
+
+		bool accept( const char *text )
+		{
+			if( ( m_token.type == OperatorToken || m_token.type == NameToken ) && m_token.text == text )
+			{
+				nextToken();
+				return true;
+			}
+			return false;
+		}
+
+		void expect( const char *text )
+		{
+			if( !accept( text ) )
+			{
+				error( std::string( "Expected \"" ) + text + "\"" );
+			}
+		}
+
+		std::string expectString()
+		{
+			if( m_token.type != StringToken )
+			{
+				error( "Expected string" );
+			}
+			std::string result = m_token.text;
+			nextToken();
+			return result;
+		}
+
+		void error( const std::string &message ) const
+		{
+			throw IECore::Exception( boost::str(
+				boost::format( "Syntax error at position %d : %s" ) % m_token.position % message
+			) );
+		}
+
+		//////////////////////////////////////////////////////////////////
+		// Syntax tree
+		//////////////////////////////////////////////////////////////////
+
+		struct SyntaxNode;
+		typedef boost::shared_ptr<SyntaxNode> SyntaxNodePtr;
+
+		// Nodes use the opcode they will eventually be compiled
+		// to, with the jump opcodes representing the operators
+		// which are compiled to use them.
+		struct SyntaxNode
+		{
+			SyntaxNode( OpCode code, double value = 0.0, size_t index = 0 )
+				:	code( code ), value( value ), index( index )
+			{
+			}
+
+			OpCode code;
+			double value;
+			size_t index;
+			std::vector<SyntaxNodePtr> children;
+		};
+
+		SyntaxNodePtr node( OpCode code, SyntaxNodePtr child0, SyntaxNodePtr child1 = SyntaxNodePtr(), SyntaxNodePtr child2 = SyntaxNodePtr() )
+		{
+			SyntaxNodePtr result( new SyntaxNode( code ) );
+			result->children.push_back( child0 );
+			if( child1 )
+			{
+				result->children.push_back( child1 );
+			}
+			if( child2 )
+			{
+				result->children.push_back( child2 );
+			}
+			return result;
+		}
+
+		//////////////////////////////////////////////////////////////////
+		// Grammar. Each method corresponds to a rule of the same name
+		// in the python grammar, pruned to the parts we support.
+		//////////////////////////////////////////////////////////////////
+
+		// "parent" ( "[" string "]" )+
+		std::string plugPath()
+		{
+			if( m_token.type != NameToken || m_token.text != "parent" )
+			{
+				error( "Expected \"parent\"" );
+			}
+			nextToken();
+
+			std::string result;
+			do
+			{
+				expect( "[" );
+				if( result.size() )
+				{
+					result += ".";
+				}
+				result += expectString();
+				expect( "]" );
+			} while( m_token.type == OperatorToken && m_token.text == "[" );
+
+			return result;
+		}
+
+		// or_test [ "if" or_test "else" test ]
+		SyntaxNodePtr test()
+		{
+			SyntaxNodePtr result = orTest();
+			if( accept( "if" ) )
+			{
+				SyntaxNodePtr condition = orTest();
+				expect( "else" );
+				SyntaxNodePtr alternative = test();
+				result = node( JumpIfFalse, condition, result, alternative );
+			}
+			return result;
+		}
+
+		// and_test ( "or" and_test )*
+		SyntaxNodePtr orTest()
+		{
+			SyntaxNodePtr result = andTest();
+			while( accept( "or" ) )
+			{
+				result = node( JumpIfTrueOrPop, result, andTest() );
+			}
+			return result;
+		}
+
+		// not_test ( "and" not_test )*
+		SyntaxNodePtr andTest()
+		{
+			SyntaxNodePtr result = notTest();
+			while( accept( "and" ) )
+			{
+				result = node( JumpIfFalseOrPop, result, notTest() );
+			}
+			return result;
+		}
+
+		// "not" not_test | comparison
+		SyntaxNodePtr notTest()
+		{
+			if( accept( "not" ) )
+			{
+				return node( Not, notTest() );
+			}
+			return comparison();
+		}
+
+		// expr [ comp_op expr ]
+		SyntaxNodePtr comparison()
+		{
+			SyntaxNodePtr result = expr();
+			static const char *operators[] = { "<", "<=", ">", ">=", "==", "!=", 0 };
+			static const OpCode opCodes[] = { Less, LessEqual, Greater, GreaterEqual, Equal, NotEqual };
+			for( int i = 0; operators[i]; ++i )
+			{
+				if( accept( operators[i] ) )
+				{
+					result = node( opCodes[i], result, expr() );
+					break;
+				}
+			}
+			return result;
+		}
+
+		// term ( ( "+" | "-" ) term )*
+		SyntaxNodePtr expr()
+		{
+			SyntaxNodePtr result = term();
+			while( true )
+			{
+				if( accept( "+" ) )
+				{
+					result = node( Add, result, term() );
+				}
+				else if( accept( "-" ) )
+				{
+					result = node( Subtract, result, term() );
+				}
+				else
+				{
+					return result;
+				}
+			}
+		}
+
+		// factor ( ( "*" | "/" | "//" | "%" ) factor )*
+		SyntaxNodePtr term()
+		{
+			SyntaxNodePtr result = factor();
+			while( true )
+			{
+				if( accept( "*" ) )
+				{
+					result = node( Multiply, result, factor() );
+				}
+				else if( accept( "/" ) )
+				{
+					result = node( Divide, result, factor() );
+				}
+				else if( accept( "//" ) )
+				{
+					result = node( FloorDivide, result, factor() );
+				}
+				else if( accept( "%" ) )
+				{
+					result = node( Modulo, result, factor() );
+				}
+				else
+				{
+					return result;
+				}
+			}
+		}
+
+		// ( "+" | "-" ) factor | power
+		SyntaxNodePtr factor()
+		{
+			if( accept( "+" ) )
+			{
+				return factor();
+			}
+			else if( accept( "-" ) )
+			{
+				return node( Negate, factor() );
+			}
+			return power();
+		}
+
+		// atom [ "**" factor ]
+		SyntaxNodePtr power()
+		{
+			SyntaxNodePtr result = atom();
+			if( accept( "**" ) )
+			{
+				result = node( Power, result, factor() );
+			}
+			return result;
+		}
+
+		SyntaxNodePtr atom()
+		{
+			if( m_token.type == NumberToken )
+			{
+				double value = 0;
+				try
+				{
+					value = boost::lexical_cast<double>( m_token.text );
+				}
+				catch( const boost::bad_lexical_cast & )
+				{
+					error( "Invalid number \"" + m_token.text + "\"" );
+				}
+				nextToken();
+				return SyntaxNodePtr( new SyntaxNode( Constant, value ) );
+			}
+			else if( accept( "(" ) )
+			{
+				SyntaxNodePtr result = test();
+				expect( ")" );
+				return result;
+			}
+			else if( m_token.type != NameToken )
+			{
+				error( m_token.type == EndToken ? "Unexpected end of expression" : "Unexpected \"" + m_token.text + "\"" );
+			}
+
+			if( m_token.text == "parent" )
+			{
+				return SyntaxNodePtr( new SyntaxNode( Input, 0, inPlugIndex( plugPath() ) ) );
+			}
+			else if( accept( "context" ) )
+			{
+				return contextAccess();
+			}
+			else if( accept( "True" ) )
+			{
+				return SyntaxNodePtr( new SyntaxNode( Constant, 1.0 ) );
+			}
+			else if( accept( "False" ) )
+			{
+				return SyntaxNodePtr( new SyntaxNode( Constant, 0.0 ) );
+			}
+
+			return call();
+		}
+
+		// "[" string "]" | ".getFrame" "(" ")" | ".get" "(" string [ "," test ] ")"
+		SyntaxNodePtr contextAccess()
+		{
+			if( accept( "[" ) )
+			{
+				SyntaxNodePtr result( new SyntaxNode( ContextVariable, 0, contextNameIndex( expectString() ) ) );
+				expect( "]" );
+				return result;
+			}
+
+			expect( "." );
+			if( accept( "getFrame" ) )
+			{
+				expect( "(" );
+				expect( ")" );
+				return SyntaxNodePtr( new SyntaxNode( ContextVariable, 0, contextNameIndex( "frame" ) ) );
+			}
+
+			expect( "get" );
+			expect( "(" );
+			SyntaxNodePtr result( new SyntaxNode( ContextVariable, 0, contextNameIndex( expectString() ) ) );
+			if( accept( "," ) )
+			{
+				result->code = ContextVariableWithDefault;
+				result->children.push_back( test() );
+			}
+			expect( ")" );
+			return result;
+		}
+
+		// name "(" test ( "," test )* ")"
+		SyntaxNodePtr call()
+		{
+			const std::string name = m_token.text;
+			OpCode code = Abs;
+			size_t minArguments = 1, maxArguments = 1;
+			if( name == "abs" )
+			{
+				code = Abs;
+			}
+			else if( name == "min" || name == "max" )
+			{
+				code = name == "min" ? Min : Max;
+				minArguments = 2;
+				maxArguments = g_maxStackSize;
+			}
+			else if( name == "pow" )
+			{
+				code = Power;
+				minArguments = maxArguments = 2;
+			}
+			else if( name == "round" )
+			{
+				code = Round;
+			}
+			else if( name == "int" )
+			{
+				code = Int;
+			}
+			else if( name == "float" )
+			{
+				// all our values are floats already, so we
+				// compile this as a unary plus.
+				code = Add;
+			}
+			else if( name == "bool" )
+			{
+				code = Bool;
+			}
+			else
+			{
+				error( "Unsupported name \"" + name + "\"" );
+			}
+			nextToken();
+
+			SyntaxNodePtr result( new SyntaxNode( code ) );
+			expect( "(" );
+			do
+			{
+				result->children.push_back( test() );
+			} while( accept( "," ) );
+			expect( ")" );
+
+			if( result->children.size() < minArguments || result->children.size() > maxArguments )
+			{
+				error( boost::str( boost::format( "Wrong number of arguments to %s()" ) % name ) );
+			}
+
+			if( code == Add )
+			{
+				return result->children[0];
+			}
+			result->index = result->children.size();
+			return result;
+		}
+
+		size_t inPlugIndex( const std::string &plugPath )
+		{
+			std::vector<std::string> &inPlugs = m_engine->m_inPlugs;
+			std::vector<std::string>::const_iterator it = std::find( inPlugs.begin(), inPlugs.end(), plugPath );
+			if( it != inPlugs.end() )
+			{
+				return it - inPlugs.begin();
+			}
+			inPlugs.push_back( plugPath );
+			return inPlugs.size() - 1;
+		}
+
+		size_t contextNameIndex( const std::string &name )
+		{
+			std::vector<InternedString> &names = m_engine->m_contextNames;
+			std::vector<InternedString>::const_iterator it = std::find( names.begin(), names.end(), InternedString( name ) );
+			if( it != names.end() )
+			{
+				return it - names.begin();
+			}
+			names.push_back( name );
+			return names.size() - 1;
+		}
+
+		//////////////////////////////////////////////////////////////////
+		// Compilation
+		//////////////////////////////////////////////////////////////////
+
+		// Appends the ops for the node to the program, returning
+		// the maximum stack depth needed to execute them.
+		size_t compile( const SyntaxNode *n )
+		{
+			std::vector<Op> &program = m_engine->m_program;
+			const std::vector<SyntaxNodePtr> &children = n->children;
+
+			switch( n->code )
+			{
+				case JumpIfFalse :
+				{
+					// conditional expression, with children
+					// condition, result, alternative.
+					size_t stackSize = compile( children[0].get() );
+					const size_t jumpToAlternative = program.size();
+					program.push_back( Op( JumpIfFalse ) );
+					stackSize = std::max( stackSize, compile( children[1].get() ) );
+					const size_t jumpToEnd = program.size();
+					program.push_back( Op( Jump ) );
+					program[jumpToAlternative].index = program.size();
+					stackSize = std::max( stackSize, compile( children[2].get() ) );
+					program[jumpToEnd].index = program.size();
+					return stackSize;
+				}
+				case JumpIfFalseOrPop :
+				case JumpIfTrueOrPop :
+				{
+					// "and" and "or", which evaluate the
+					// right hand side only when necessary.
+					size_t stackSize = compile( children[0].get() );
+					const size_t jump = program.size();
+					program.push_back( Op( n->code ) );
+					stackSize = std::max( stackSize, compile( children[1].get() ) );
+					program[jump].index = program.size();
+					return stackSize;
+				}
+				default :
+				{
+					// everything else just operates on the
+					// results of its children.
+					size_t stackSize = 1;
+					for( size_t i = 0; i < children.size(); ++i )
+					{
+						stackSize = std::max( stackSize, i + compile( children[i].get() ) );
+					}
+					program.push_back( Op( n->code, n->value, n->index ) );
+					return stackSize;
+				}
+			}
+		}
+
+		const std::string &m_expression;
+		size_t m_position;
+		Token m_token;
+		ArithmeticExpressionEngine *m_engine;
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// ArithmeticExpressionEngine
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+double plugValue( const ValuePlug *plug )
+{
+	switch( (Gaffer::TypeId)plug->typeId() )
+	{
+		case FloatPlugTypeId :
+			return static_cast<const FloatPlug *>( plug )->getValue();
+		case IntPlugTypeId :
+			return static_cast<const IntPlug *>( plug )->getValue();
+		case BoolPlugTypeId :
+			return static_cast<const BoolPlug *>( plug )->getValue();
+		default :
+			throw IECore::Exception( boost::str( boost::format( "Unsupported plug type \"%s\"" ) % plug->typeName() ) );
+	}
+}
+
+double dataValue( const Data *data, const InternedString &name )
+{
+	switch( data->typeId() )
+	{
+		case FloatDataTypeId :
+			return static_cast<const FloatData *>( data )->readable();
+		case DoubleDataTypeId :
+			return static_cast<const DoubleData *>( data )->readable();
+		case IntDataTypeId :
+			return static_cast<const IntData *>( data )->readable();
+		case BoolDataTypeId :
+			return static_cast<const BoolData *>( data )->readable();
+		default :
+			throw IECore::Exception( boost::str( boost::format( "Context variable \"%s\" has unsupported type \"%s\"" ) % name.string() % data->typeName() ) );
+	}
+}
+
+double checkedDivisor( double divisor )
+{
+	if( divisor == 0.0 )
+	{
+		throw IECore::Exception( "Division by zero" );
+	}
+	return divisor;
+}
+
+} // namespace
+
+Expression::Engine::EngineDescription<ArithmeticExpressionEngine> ArithmeticExpressionEngine::g_engineDescription( "arithmetic" );
+
+ArithmeticExpressionEngine::Op::Op( OpCode code, double value, size_t index )
+	:	code( code ), value( value ), index( index )
+{
+}
+
+ArithmeticExpressionEngine::ArithmeticExpressionEngine( const std::string &expression )
+	:	m_stackSize( 0 )
+{
+	Parser parser( expression, this );
+}
+
+ArithmeticExpressionEngine::~ArithmeticExpressionEngine()
+{
+}
+
+std::string ArithmeticExpressionEngine::outPlug()
+{
+	return m_outPlug;
+}
+
+void ArithmeticExpressionEngine::inPlugs( std::vector<std::string> &plugPaths )
+{
+	plugPaths.insert( plugPaths.end(), m_inPlugs.begin(), m_inPlugs.end() );
+}
+
+void ArithmeticExpressionEngine::contextNames( std::vector<std::string> &names )
+{
+	for( std::vector<InternedString>::const_iterator it = m_contextNames.begin(), eIt = m_contextNames.end(); it != eIt; ++it )
+	{
+		names.push_back( it->string() );
+	}
+}
+
+void ArithmeticExpressionEngine::execute( const Context *context, const std::vector<const ValuePlug *> &proxyInputs, ValuePlug *proxyOutput )
+{
+	double stack[g_maxStackSize];
+	// points to the next free element
+	double *top = stack;
+
+	const Op *program = &m_program.front();
+	const size_t programSize = m_program.size();
+	for( size_t i = 0; i < programSize; ++i )
+	{
+		const Op &op = program[i];
+		switch( op.code )
+		{
+			case Constant :
+				*top++ = op.value;
+				break;
+			case Input :
+				*top++ = plugValue( proxyInputs[op.index] );
+				break;
+			case ContextVariable :
+			{
+				const InternedString &name = m_contextNames[op.index];
+				*top++ = dataValue( context->get<Data>( name ), name );
+				break;
+			}
+			case ContextVariableWithDefault :
+			{
+				// the default is already on the stack, and
+				// we replace it if the variable exists.
+				const InternedString &name = m_contextNames[op.index];
+				if( const Data *data = context->get<Data>( name, 0 ) )
+				{
+					top[-1] = dataValue( data, name );
+				}
+				break;
+			}
+			case Negate :
+				top[-1] = -top[-1];
+				break;
+			case Not :
+				top[-1] = top[-1] == 0.0;
+				break;
+			case Add :
+				top--;
+				top[-1] += *top;
+				break;
+			case Subtract :
+				top--;
+				top[-1] -= *top;
+				break;
+			case Multiply :
+				top--;
+				top[-1] *= *top;
+				break;
+			case Divide :
+				top--;
+				top[-1] /= checkedDivisor( *top );
+				break;
+			case FloorDivide :
+				top--;
+				top[-1] = floor( top[-1] / checkedDivisor( *top ) );
+				break;
+			case Modulo :
+				// python semantics, where the result has
+				// the same sign as the divisor.
+				top--;
+				top[-1] = top[-1] - *top * floor( top[-1] / checkedDivisor( *top ) );
+				break;
+			case Power :
+				top--;
+				top[-1] = pow( top[-1], *top );
+				break;
+			case Less :
+				top--;
+				top[-1] = top[-1] < *top;
+				break;
+			case LessEqual :
+				top--;
+				top[-1] = top[-1] <= *top;
+				break;
+			case Greater :
+				top--;
+				top[-1] = top[-1] > *top;
+				break;
+			case GreaterEqual :
+				top--;
+				top[-1] = top[-1] >= *top;
+				break;
+			case Equal :
+				top--;
+				top[-1] = top[-1] == *top;
+				break;
+			case NotEqual :
+				top--;
+				top[-1] = top[-1] != *top;
+				break;
+			case Abs :
+				top[-1] = fabs( top[-1] );
+				break;
+			case Min :
+			case Max :
+			{
+				// index holds the number of arguments
+				double *first = top - op.index;
+				double result = *first;
+				for( double *v = first + 1; v < top; ++v )
+				{
+					result = op.code == Min ? std::min( result, *v ) : std::max( result, *v );
+				}
+				top = first;
+				*top++ = result;
+				break;
+			}
+			case Round :
+				// python rounds halfway cases away from zero
+				top[-1] = top[-1] < 0.0 ? ceil( top[-1] - 0.5 ) : floor( top[-1] + 0.5 );
+				break;
+			case Int :
+				top[-1] = top[-1] < 0.0 ? ceil( top[-1] ) : floor( top[-1] );
+				break;
+			case Bool :
+				top[-1] = top[-1] != 0.0;
+				break;
+			case Jump :
+				i = op.index - 1;
+				break;
+			case JumpIfFalse :
+				if( *--top == 0.0 )
+				{
+					i = op.index - 1;
+				}
+				break;
+			case JumpIfFalseOrPop :
+				if( top[-1] == 0.0 )
+				{
+					i = op.index - 1;
+				}
+				else
+				{
+					top--;
+				}
+				break;
+			case JumpIfTrueOrPop :
+				if( top[-1] != 0.0 )
+				{
+					i = op.index - 1;
+				}
+				else
+				{
+					top--;
+				}
+				break;
+		}
+	}
+
+	const double result = top[-1];
+	switch( (Gaffer::TypeId)proxyOutput->typeId() )
+	{
+		case FloatPlugTypeId :
+			static_cast<FloatPlug *>( proxyOutput )->setValue( result );
+			break;
+		case IntPlugTypeId :
+			// The comparisons also fail for NaN, which would
+			// otherwise be undefined to convert.
+			if( !( result >= (double)std::numeric_limits<int>::min() && result <= (double)std::numeric_limits<int>::max() ) )
+			{
+				throw IECore::Exception( boost::str( boost::format( "Result %g cannot be represented by an IntPlug" ) % result ) );
+			}
+			static_cast<IntPlug *>( proxyOutput )->setValue( static_cast<int>( result ) );
+			break;
+		case BoolPlugTypeId :
+			static_cast<BoolPlug *>( proxyOutput )->setValue( result != 0.0 );
+			break;
+		default :
+			throw IECore::Exception( boost::str( boost::format( "Unsupported plug type \"%s\"" ) % proxyOutput->typeName() ) );
+	}
+}
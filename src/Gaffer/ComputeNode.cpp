@@ -77,3 +77,18 @@ void ComputeNode::hash( const ValuePlug *output, const Context *context, IECore:
 void ComputeNode::compute( ValuePlug *output, const Context *context ) const
 {
 }
+
+bool ComputeNode::shareComputations( const ValuePlug *output ) const
+{
+	return true;
+}
+
+ValuePlug::CachePolicy ComputeNode::cachePolicy( const ValuePlug *output ) const
+{
+	return ValuePlug::Cached;
+}
+
+size_t ComputeNode::cacheComputeTimeThreshold( const ValuePlug *output ) const
+{
+	return ValuePlug::getCacheComputeTimeThreshold();
+}
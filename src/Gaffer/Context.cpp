@@ -36,6 +36,8 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include <stack>
+#include <vector>
+#include <algorithm>
 
 #include "tbb/enumerable_thread_specific.h"
 
@@ -54,15 +56,32 @@ using namespace IECore;
 
 static InternedString g_frame( "frame" );
 
+const IECore::InternedString Context::g_fastSlotNames[Context::NumFastSlots] = {
+	g_frame,
+	"image:channelName",
+	"image:tileOrigin",
+	"scene:path"
+};
+
 Context::Context()
-	:	m_changedSignal( NULL )
+	:	m_changedSignal( NULL ), m_parent( NULL ), m_fastValues()
 {
 	set( g_frame, 1.0f );
 }
 
 Context::Context( const Context &other, Ownership ownership )
-	:	m_map( other.m_map ), m_changedSignal( NULL )
+	:	m_map( other.m_parent ? other.m_parent->m_map : other.m_map ), m_changedSignal( NULL ), m_parent( NULL ), m_hash( other.m_hash ), m_fastValues()
 {
+	if( other.m_parent )
+	{
+		// The other context is a layer created by an EditableScope,
+		// so we must combine its entries with those of its parent.
+		for( Map::const_iterator it = other.m_map.begin(), eIt = other.m_map.end(); it != eIt; ++it )
+		{
+			m_map[it->first] = it->second;
+		}
+	}
+
 	// We used the (shallow) Map copy constructor in our initialiser above
 	// because it offers a big performance win over iterating and inserting copies
 	// ourselves. Now we need to go in and tweak our copies based on the ownership.
@@ -87,9 +106,53 @@ Context::Context( const Context &other, Ownership ownership )
 				break;
 		}
 	}
+	
+	for( int i = 0; i < NumFastSlots; ++i )
+	{
+		Map::const_iterator it = m_map.find( g_fastSlotNames[i] );
+		if( it != m_map.end() )
+		{
+			m_fastValues[i] = it->second.data;
+		}
+	}
+}
+
+Context::Context( const Context *parent )
+	:	m_changedSignal( NULL ), m_parent( NULL ), m_fastValues()
+{
+	setParent( parent );
 }
 
 Context::~Context()
+{
+	clear();
+	delete m_changedSignal;
+}
+
+void Context::setParent( const Context *parent )
+{
+	m_hash = parent->m_hash;
+	std::copy( parent->m_fastValues, parent->m_fastValues + NumFastSlots, m_fastValues );
+	if( parent->m_parent )
+	{
+		// The parent is a layer itself. Rather than chain layers
+		// together, we borrow its entries and layer ourselves directly
+		// on top of its parent. Since the layers created by EditableScopes
+		// typically only contain an entry or two, this is cheap.
+		m_parent = parent->m_parent;
+		m_map = parent->m_map;
+		for( Map::iterator it = m_map.begin(), eIt = m_map.end(); it != eIt; ++it )
+		{
+			it->second.ownership = Borrowed;
+		}
+	}
+	else
+	{
+		m_parent = parent;
+	}
+}
+
+void Context::clear()
 {
 	for( Map::const_iterator it = m_map.begin(), eIt = m_map.end(); it != eIt; ++it )
 	{
@@ -98,16 +161,71 @@ Context::~Context()
 			it->second.data->removeRef();
 		}
 	}
+	m_map.clear();
+	m_parent = NULL;
+	m_hash = MurmurHash();
+	std::fill( m_fastValues, m_fastValues + NumFastSlots, (const Data *)NULL );
+}
+
+template<typename F>
+void Context::visitEntries( F &f ) const
+{
+	if( !m_parent )
+	{
+		for( Map::const_iterator it = m_map.begin(), eIt = m_map.end(); it != eIt; ++it )
+		{
+			f( it->first, it->second );
+		}
+		return;
+	}
 	
-	delete m_changedSignal;
+	// Merge our entries with those of our parent, giving
+	// precedence to our own.
+	const Map::key_compare less = m_map.key_comp();
+	Map::const_iterator it = m_map.begin(), eIt = m_map.end();
+	Map::const_iterator pIt = m_parent->m_map.begin(), pEIt = m_parent->m_map.end();
+	while( it != eIt || pIt != pEIt )
+	{
+		if( pIt == pEIt || ( it != eIt && !less( pIt->first, it->first ) ) )
+		{
+			if( pIt != pEIt && !less( it->first, pIt->first ) )
+			{
+				// overridden by our entry
+				++pIt;
+			}
+			f( it->first, it->second );
+			++it;
+		}
+		else
+		{
+			f( pIt->first, pIt->second );
+			++pIt;
+		}
+	}
 }
 
-void Context::names( std::vector<IECore::InternedString> &names ) const
+namespace
+{
+
+struct NameAccumulator
 {
-	for( Map::const_iterator it = m_map.begin(), eIt = m_map.end(); it != eIt; it++ )
+	NameAccumulator( std::vector<IECore::InternedString> &names ) : m_names( names ) {}
+	
+	template<typename S>
+	void operator()( const InternedString &name, const S &storage )
 	{
-		names.push_back( it->first );
+		m_names.push_back( name );
 	}
+	
+	std::vector<IECore::InternedString> &m_names;
+};
+
+} // namespace
+
+void Context::names( std::vector<IECore::InternedString> &names ) const
+{
+	NameAccumulator accumulator( names );
+	visitEntries( accumulator );
 }
 
 float Context::getFrame() const
@@ -137,17 +255,18 @@ Context::ChangedSignal &Context::changedSignal()
 
 IECore::MurmurHash Context::hash() const
 {
-	IECore::MurmurHash result;
-	for( Map::const_iterator it = m_map.begin(), eIt = m_map.end(); it != eIt; it++ )
-	{
-		result.append( it->first );
-		it->second.data->hash( result );
-	}
-	return result;
+	return m_hash;
 }
 
 bool Context::operator == ( const Context &other ) const
 {
+	if( m_parent || other.m_parent )
+	{
+		// comparisons aren't performance critical, so we
+		// simply compare flattened copies of any layers.
+		return Context( *this, Borrowed ) == Context( other, Borrowed );
+	}
+
 	if( m_map.size() != other.m_map.size() )
 	{
 		return false;
@@ -289,26 +408,69 @@ void Context::substituteInternal( const std::string &s, std::string &result, con
 //////////////////////////////////////////////////////////////////////////
 
 typedef std::stack<const Context *> ContextStack;
-typedef tbb::enumerable_thread_specific<ContextStack> ThreadSpecificContextStack;
 
-static ThreadSpecificContextStack g_threadContexts;
+// Each thread maintains a stack of current contexts, and a pool
+// of layered contexts for reuse by EditableScopes.
+struct ThreadState
+{
+	ContextStack stack;
+	std::vector<ContextPtr> pool;
+};
+
+typedef tbb::enumerable_thread_specific<ThreadState> ThreadSpecificState;
+
+static ThreadSpecificState g_threadStates;
 static ContextPtr g_defaultContext = new Context;
 
 Context::Scope::Scope( const Context *context )
 {
-	ContextStack &stack = g_threadContexts.local();
+	ContextStack &stack = g_threadStates.local().stack;
 	stack.push( context );
 }
 
 Context::Scope::~Scope()
 {
-	ContextStack &stack = g_threadContexts.local();
+	ContextStack &stack = g_threadStates.local().stack;
 	stack.pop();
 }
 
+Context::EditableScope::EditableScope( const Context *context )
+{
+	ThreadState &threadState = g_threadStates.local();
+	if( threadState.pool.size() )
+	{
+		m_context = threadState.pool.back();
+		threadState.pool.pop_back();
+		m_context->setParent( context );
+	}
+	else
+	{
+		m_context = new Context( context );
+	}
+	threadState.stack.push( m_context.get() );
+}
+
+Context::EditableScope::~EditableScope()
+{
+	ThreadState &threadState = g_threadStates.local();
+	threadState.stack.pop();
+	if( m_context->refCount() == 1 )
+	{
+		// No-one else has taken a reference to the context,
+		// so we can recycle it for the next scope.
+		m_context->clear();
+		threadState.pool.push_back( m_context );
+	}
+}
+
+void Context::EditableScope::setFrame( float frame )
+{
+	m_context->setFrame( frame );
+}
+
 const Context *Context::current()
 {
-	ContextStack &stack = g_threadContexts.local();
+	ContextStack &stack = g_threadStates.local().stack;
 	if( !stack.size() )
 	{
 		return g_defaultContext;
@@ -36,10 +36,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "tbb/enumerable_thread_specific.h"
-
-#include "boost/multi_index_container.hpp"
-#include "boost/multi_index/sequenced_index.hpp"
-#include "boost/multi_index/ordered_index.hpp"
+#include "tbb/atomic.h"
 
 #include "Gaffer/DependencyNode.h"
 #include "Gaffer/ValuePlug.h"
@@ -51,7 +48,7 @@ using namespace Gaffer;
 IE_CORE_DEFINERUNTIMETYPED( DependencyNode );
 
 DependencyNode::DependencyNode( const std::string &name )
-	:	Node( name )
+	:	Node( name ), m_affectsTableVersion( 0 )
 {
 }
 
@@ -92,18 +89,46 @@ const Plug *DependencyNode::correspondingInput( const Plug *output ) const
 // Dirty propagation
 //////////////////////////////////////////////////////////////////////////
 
-typedef boost::multi_index::multi_index_container<
-	Plug *,
-	boost::multi_index::indexed_by<
-		boost::multi_index::sequenced<>,
-		boost::multi_index::ordered_unique<boost::multi_index::identity<Plug *> >
-	>
-> DirtyPlugsContainer;
+namespace
+{
 
-typedef DirtyPlugsContainer::iterator DirtyPlugsIterator;
+// we don't propagate dirtiness immediately for each plug that is edited, for
+// two reasons :
+//
+// - we don't want to emit dirtiness for the same plug more than once
+// - we don't want to emit dirtiness while the graph may still be being
+//   rewired by slots connected to plugSetSignal() or plugInputChangedSignal()
+//
+// instead we collect the edited plugs, and only when the outermost
+// DirtyPropagationScope closes (or immediately if there isn't one) do we
+// emit plugDirtiedSignal(). the hashes of the affected plugs are always
+// invalidated immediately though, as computations may be performed within
+// the scope, and they must not see (or cache) stale hashes.
+//
+// the state is stored per-thread as although it's illegal to be monkeying
+// with a script from multiple threads, it's perfectly legal to be monkeying
+// with a different script in each thread.
+struct DirtyPropagationState
+{
+
+	DirtyPropagationState()
+		:	scopeCount( 0 )
+	{
+	}
+
+	size_t scopeCount;
+	// we hold references to the plugs, because they may
+	// be removed from the graph before the scope closes.
+	std::vector<PlugPtr> dirtyPlugs;
+
+};
+
+tbb::enumerable_thread_specific<DirtyPropagationState> g_dirtyPropagationStates;
+
+tbb::atomic<size_t> g_affectsTablesVersion;
+
+} // namespace
 
-static tbb::enumerable_thread_specific<DirtyPlugsContainer> g_dirtyPlugsContainers;
-		
 void DependencyNode::propagateDirtiness( Plug *plugToDirty )
 {
 	// we're not able to signal anything if there's no node, so just early out
@@ -113,87 +138,194 @@ void DependencyNode::propagateDirtiness( Plug *plugToDirty )
 		return;
 	}
 	
-	// we don't emit dirtiness immediately for each plug as we traverse the
-	// dependency graph for two reasons :
-	//
-	// - we don't want to emit dirtiness for the same plug more than once
-	// - we don't want to emit dirtiness while the graph may still be being
-	//   rewired by slots connected to plugSetSignal() or plugInputChangedSignal()
-	//
-	// instead we collect all the dirty plugs in a container as we traverse
-	// the graph and only when the traversal is complete do we emit the plugDirtiedSignal().
-	//
-	// the container used is stored per-thread as although it's illegal to be
-	// monkeying with a script from multiple threads, it's perfectly legal to
-	// be monkeying with a different script in each thread.
+	// affects() may depend on the values of the node's own plugs,
+	// so we must discard any results cached for the edited node.
+	if( DependencyNode *dependencyNode = IECore::runTimeCast<DependencyNode>( node ) )
+	{
+		dependencyNode->m_affectsTable.clear();
+	}
+	
+	DirtyPropagationState &state = g_dirtyPropagationStates.local();
+	state.dirtyPlugs.push_back( plugToDirty );
+	if( !state.scopeCount )
+	{
+		emitDirtiness();
+		return;
+	}
 	
-	DirtyPlugsContainer &dirtyPlugs = g_dirtyPlugsContainers.local();
+	// we're deferring the signalling, but not the invalidation of hashes.
+	// emitDirtiness() will dirty these plugs again, which is harmless, and
+	// also catches any plugs which are connected downstream in the meantime.
+	VisitedPlugs visited;
+	std::vector<Plug *> order;
+	visitDirtiness( plugToDirty, visited, order );
+	for( std::vector<Plug *>::const_iterator it = order.begin(), eIt = order.end(); it != eIt; ++it )
+	{
+		if( ValuePlug *valuePlug = IECore::runTimeCast<ValuePlug>( *it ) )
+		{
+			valuePlug->dirty();
+		}
+	}
+}
+
+void DependencyNode::pushDirtyPropagationScope()
+{
+	g_dirtyPropagationStates.local().scopeCount++;
+}
+
+void DependencyNode::popDirtyPropagationScope()
+{
+	DirtyPropagationState &state = g_dirtyPropagationStates.local();
+	if( --state.scopeCount == 0 )
+	{
+		emitDirtiness();
+	}
+}
+
+void DependencyNode::emitDirtiness()
+{
+	DirtyPropagationState &state = g_dirtyPropagationStates.local();
 	
-	// if the container is currently empty then we are at the start of a traversal,
-	// and will emit plugDirtiedSignal() and empty the container before returning
-	// from this function. if the container isn't empty then we are mid-traversal
-	// and will just add to it.
-	const bool emit = dirtyPlugs.empty();
-
-	Plug *p = plugToDirty;
-	while( p )
+	// slots connected to plugDirtiedSignal() may make further edits. we
+	// treat the emission as a scope of its own so that those edits are
+	// collected, and then emit for them in a subsequent pass.
+	state.scopeCount++;
+	try
 	{
-		// push the plug onto the back of the list of dirty plugs
-		std::pair<DirtyPlugsIterator, bool> i = dirtyPlugs.push_back( p );
-		if( !i.second )
+		while( state.dirtyPlugs.size() )
 		{
-			// if that failed, it's because it's elsewhere in the
-			// list already. move it to the back - this ensures that
-			// dirtiness is only signalled for a plug after it has been
-			// signalled for all dirty plugs it depends on, and all dirty
-			// plugs it is a parent of.
-			dirtyPlugs.relocate( dirtyPlugs.end(), i.first );
+			std::vector<PlugPtr> dirtyPlugs;
+			dirtyPlugs.swap( state.dirtyPlugs );
+		
+			// plugs may have been edited several times, and we
+			// want to treat them as if they were edited only once,
+			// at the time of the first edit.
+			VisitedPlugs edited;
+			std::vector<Plug *> uniqueDirtyPlugs;
+			for( std::vector<PlugPtr>::const_iterator it = dirtyPlugs.begin(), eIt = dirtyPlugs.end(); it != eIt; ++it )
+			{
+				if( edited.insert( it->get() ).second )
+				{
+					uniqueDirtyPlugs.push_back( it->get() );
+				}
+			}
+		
+			VisitedPlugs visited;
+			std::vector<Plug *> order;
+			for( std::vector<Plug *>::const_reverse_iterator it = uniqueDirtyPlugs.rbegin(), eIt = uniqueDirtyPlugs.rend(); it != eIt; ++it )
+			{
+				visitDirtiness( *it, visited, order );
+			}
+			
+			// the visitation order is a post-order traversal, so reversing it
+			// ensures that dirtiness is only signalled for a plug after it has
+			// been signalled for all dirty plugs it depends on, and all dirty
+			// plugs it is a parent of. we visited the edited plugs in reverse
+			// so that they are otherwise signalled in the order of editing.
+			// we invalidate all the hashes before signalling anything so that
+			// slots see up to date values.
+			for( std::vector<Plug *>::const_reverse_iterator it = order.rbegin(), eIt = order.rend(); it != eIt; ++it )
+			{
+				if( ValuePlug *valuePlug = IECore::runTimeCast<ValuePlug>( *it ) )
+				{
+					valuePlug->dirty();
+				}
+			}
+			
+			for( std::vector<Plug *>::const_reverse_iterator it = order.rbegin(), eIt = order.rend(); it != eIt; ++it )
+			{
+				Plug *plug = *it;
+				Node *node = plug->node();
+				if( node )
+				{
+					node->plugDirtiedSignal()( plug );
+				}
+			}
 		}
-		p = p->parent<Plug>();
+	}
+	catch( ... )
+	{
+		state.dirtyPlugs.clear();
+		state.scopeCount--;
+		throw;
+	}
+	state.scopeCount--;
+}
+
+void DependencyNode::visitDirtiness( Plug *plug, VisitedPlugs &visited, std::vector<Plug *> &order )
+{
+	if( !visited.insert( plug ).second )
+	{
+		return;
 	}
 	
+	// the order is reversed before signalling, so we visit everything in
+	// reverse too. this means that a plug is followed by its parent, then
+	// the plugs returned by affects() in order, and then its outputs in the
+	// order they were connected.
+	//
 	// we only propagate dirtiness along leaf level plugs, because
 	// they are the only plugs which can be the target of the affects(),
 	// and compute() methods.
-	if( !plugToDirty->isInstanceOf( (IECore::TypeId)CompoundPlugTypeId ) )
+	if( !plug->isInstanceOf( (IECore::TypeId)CompoundPlugTypeId ) )
 	{
-		DependencyNode *dependencyNode = IECore::runTimeCast<DependencyNode>( node );
-		if( dependencyNode )
+		const Plug::OutputContainer &outputs = plug->outputs();
+		for( Plug::OutputContainer::const_reverse_iterator it=outputs.rbegin(), eIt=outputs.rend(); it!=eIt; ++it )
+		{
+			visitDirtiness( *it, visited, order );
+		}
+	
+		if( const DependencyNode *dependencyNode = IECore::runTimeCast<const DependencyNode>( plug->node() ) )
 		{
-			AffectedPlugsContainer affected;
-			dependencyNode->affects( plugToDirty, affected );
-			for( AffectedPlugsContainer::const_iterator it=affected.begin(); it!=affected.end(); it++ )
+			const AffectedPlugsContainer &affected = dependencyNode->affectsTable( plug );
+			for( AffectedPlugsContainer::const_reverse_iterator it=affected.rbegin(); it!=affected.rend(); it++ )
 			{
-				if( ( *it )->isInstanceOf( (IECore::TypeId)Gaffer::CompoundPlugTypeId ) )
-				{
-					// DependencyNode::affects() implementations are only allowed to place leaf plugs in the outputs,
-					// so we helpfully report any mistakes.
-					dirtyPlugs.clear();
-					throw IECore::Exception( "Non-leaf plug " + (*it)->fullName() + " cannot be returned by affects()" );
-				}
 				// cast is ok - AffectedPlugsContainer only holds const pointers so that
 				// affects() can be const to discourage implementations from having side effects.
-				propagateDirtiness( const_cast<Plug *>( *it ) );
+				visitDirtiness( const_cast<Plug *>( *it ), visited, order );
 			}
 		}
+	}
 	
-		for( Plug::OutputContainer::const_iterator it=plugToDirty->outputs().begin(), eIt=plugToDirty->outputs().end(); it!=eIt; ++it )
-		{
-			propagateDirtiness( *it );
-		}		
+	if( Plug *parent = plug->parent<Plug>() )
+	{
+		visitDirtiness( parent, visited, order );
 	}
 	
-	if( emit )
+	order.push_back( plug );
+}
+
+const DependencyNode::AffectedPlugsContainer &DependencyNode::affectsTable( const Plug *input ) const
+{
+	const size_t version = g_affectsTablesVersion;
+	if( m_affectsTableVersion != version )
 	{
-		for( DirtyPlugsIterator it = dirtyPlugs.begin(), eIt = dirtyPlugs.end(); it != eIt; ++it )
+		m_affectsTable.clear();
+		m_affectsTableVersion = version;
+	}
+	
+	AffectsTable::const_iterator it = m_affectsTable.find( input );
+	if( it != m_affectsTable.end() )
+	{
+		return it->second;
+	}
+	
+	AffectedPlugsContainer affected;
+	affects( input, affected );
+	for( AffectedPlugsContainer::const_iterator it = affected.begin(), eIt = affected.end(); it != eIt; ++it )
+	{
+		if( ( *it )->isInstanceOf( (IECore::TypeId)Gaffer::CompoundPlugTypeId ) )
 		{
-			Plug *plug = *it;
-			Node *node = plug->node();
-			if( node )
-			{
-				node->plugDirtiedSignal()( plug );
-			}
+			// DependencyNode::affects() implementations are only allowed to place leaf plugs in the outputs,
+			// so we helpfully report any mistakes.
+			throw IECore::Exception( "Non-leaf plug " + (*it)->fullName() + " cannot be returned by affects()" );
 		}
-		dirtyPlugs.clear();
 	}
+	
+	return m_affectsTable.insert( AffectsTable::value_type( input, affected ) ).first->second;
+}
+
+void DependencyNode::invalidateAffectsTables()
+{
+	++g_affectsTablesVersion;
 }
@@ -35,6 +35,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "boost/filesystem.hpp"
+#include "boost/format.hpp"
 
 #include "IECore/FrameRange.h"
 #include "IECore/MessageHandler.h"
@@ -42,6 +43,7 @@
 #include "Gaffer/CompoundPlug.h"
 #include "Gaffer/Context.h"
 #include "Gaffer/Dispatcher.h"
+#include "Gaffer/ExecutionLedger.h"
 #include "Gaffer/ScriptNode.h"
 
 using namespace IECore;
@@ -63,6 +65,7 @@ Dispatcher::Dispatcher( const std::string &name )
 	addChild( new StringPlug( "frameRange", Plug::In, "" ) );
 	addChild( new StringPlug( "jobName", Plug::In, "" ) );
 	addChild( new StringPlug( "jobDirectory", Plug::In, "" ) );
+	addChild( new StringPlug( "executionLedger", Plug::In, "" ) );
 }
 
 Dispatcher::~Dispatcher()
@@ -110,6 +113,13 @@ void Dispatcher::dispatch( const std::vector<ExecutableNodePtr> &nodes ) const
 	TaskDescriptions taskDescriptions;
 	uniqueTasks( tasks, taskDescriptions );
 	
+	const std::string ledgerFileName = context->substitute( executionLedgerPlug()->getValue() );
+	if( !ledgerFileName.empty() )
+	{
+		ConstExecutionLedgerPtr ledger = new ExecutionLedger( ledgerFileName );
+		removeExecutedTasks( ledger.get(), taskDescriptions );
+	}
+	
 	if ( !taskDescriptions.empty() )
 	{
 		doDispatch( taskDescriptions );
@@ -158,6 +168,16 @@ const StringPlug *Dispatcher::jobDirectoryPlug() const
 	return getChild<StringPlug>( g_firstPlugIndex + 3 );
 }
 
+StringPlug *Dispatcher::executionLedgerPlug()
+{
+	return getChild<StringPlug>( g_firstPlugIndex + 4 );
+}
+
+const StringPlug *Dispatcher::executionLedgerPlug() const
+{
+	return getChild<StringPlug>( g_firstPlugIndex + 4 );
+}
+
 const std::string Dispatcher::jobDirectory( const Context *context ) const
 {
 	std::string jobDir = context->substitute( jobDirectoryPlug()->getValue() );
@@ -298,6 +318,76 @@ void Dispatcher::uniqueTasks( const ExecutableNode::Tasks &tasks, TaskDescriptio
 	}
 }
 
+void Dispatcher::removeExecutedTasks( const ExecutionLedger *ledger, TaskDescriptions &taskDescriptions )
+{
+	// A Task must be executed if it hasn't been executed before, or if any of its
+	// requirements are to be executed, since it may depend on their results. We
+	// iterate until no more Tasks are added, because the requirements of a Task
+	// aren't guaranteed to precede it when equivalent Tasks have been merged.
+	
+	std::set<ExecutableNode::Task> toExecute;
+	for( TaskDescriptions::const_iterator it = taskDescriptions.begin(), eIt = taskDescriptions.end(); it != eIt; ++it )
+	{
+		if( !ledger->executed( it->task ) )
+		{
+			toExecute.insert( it->task );
+		}
+	}
+	
+	bool changed = true;
+	while( changed )
+	{
+		changed = false;
+		for( TaskDescriptions::const_iterator it = taskDescriptions.begin(), eIt = taskDescriptions.end(); it != eIt; ++it )
+		{
+			if( toExecute.count( it->task ) )
+			{
+				continue;
+			}
+			
+			for( std::set<ExecutableNode::Task>::const_iterator rIt = it->requirements.begin(), reIt = it->requirements.end(); rIt != reIt; ++rIt )
+			{
+				if( toExecute.count( *rIt ) )
+				{
+					toExecute.insert( it->task );
+					changed = true;
+					break;
+				}
+			}
+		}
+	}
+	
+	TaskDescriptions result;
+	result.reserve( taskDescriptions.size() );
+	for( TaskDescriptions::const_iterator it = taskDescriptions.begin(), eIt = taskDescriptions.end(); it != eIt; ++it )
+	{
+		if( !toExecute.count( it->task ) )
+		{
+			continue;
+		}
+		
+		result.push_back( TaskDescription() );
+		result.back().task = it->task;
+		for( std::set<ExecutableNode::Task>::const_iterator rIt = it->requirements.begin(), reIt = it->requirements.end(); rIt != reIt; ++rIt )
+		{
+			if( toExecute.count( *rIt ) )
+			{
+				result.back().requirements.insert( *rIt );
+			}
+		}
+	}
+	
+	if( result.size() != taskDescriptions.size() )
+	{
+		msg(
+			Msg::Info, "Dispatcher",
+			boost::str( boost::format( "Skipping %d tasks recorded as executed in \"%s\"." ) % ( taskDescriptions.size() - result.size() ) % ledger->fileName() )
+		);
+	}
+	
+	taskDescriptions.swap( result );
+}
+
 FrameListPtr Dispatcher::frameRange( const ScriptNode *script, const Context *context ) const
 {
 	FramesMode mode = (FramesMode)framesModePlug()->getValue();
@@ -153,6 +153,15 @@ IECore::MurmurHash ExecutableNode::executionHash( const Context *context ) const
 	return h;
 }
 
+void ExecutableNode::executionOutputs( const Context *context, std::vector<std::string> &fileNames ) const
+{
+}
+
+bool ExecutableNode::executionHashIsComplete() const
+{
+	return false;
+}
+
 void ExecutableNode::execute( const Contexts &contexts ) const
 {
 }
@@ -0,0 +1,192 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2014, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#include <fstream>
+
+#include "boost/filesystem.hpp"
+#include "boost/algorithm/string/split.hpp"
+#include "boost/algorithm/string/classification.hpp"
+#include "boost/lexical_cast.hpp"
+
+#include "IECore/Exception.h"
+
+#include "Gaffer/Context.h"
+#include "Gaffer/ExecutionLedger.h"
+
+using namespace IECore;
+using namespace Gaffer;
+
+// Each record is stored on a single line, as the execution hash followed
+// by a modification time and file name for each output, all separated by
+// tabs.
+
+ExecutionLedger::ExecutionLedger( const std::string &fileName )
+	:	m_fileName( fileName )
+{
+	std::ifstream file( fileName.c_str() );
+	std::string line;
+	std::vector<std::string> tokens;
+	while( std::getline( file, line ) )
+	{
+		boost::split( tokens, line, boost::is_any_of( "\t" ) );
+		if( tokens.size() % 2 != 1 || tokens[0].empty() )
+		{
+			// Most likely a record truncated by a crashed process.
+			continue;
+		}
+
+		Outputs outputs;
+		try
+		{
+			for( size_t i = 1; i < tokens.size(); i += 2 )
+			{
+				Output output;
+				output.modificationTime = boost::lexical_cast<std::time_t>( tokens[i] );
+				output.fileName = tokens[i+1];
+				outputs.push_back( output );
+			}
+		}
+		catch( const boost::bad_lexical_cast &e )
+		{
+			continue;
+		}
+
+		m_records[tokens[0]].swap( outputs );
+	}
+}
+
+ExecutionLedger::~ExecutionLedger()
+{
+}
+
+const std::string &ExecutionLedger::fileName() const
+{
+	return m_fileName;
+}
+
+bool ExecutionLedger::executed( const ExecutableNode::Task &task ) const
+{
+	if( !task.node()->executionHashIsComplete() )
+	{
+		return false;
+	}
+
+	const MurmurHash hash = task.hash();
+	if( hash == MurmurHash() )
+	{
+		return false;
+	}
+
+	Records::const_iterator it = m_records.find( hash.toString() );
+	if( it == m_records.end() )
+	{
+		return false;
+	}
+
+	Outputs currentOutputs;
+	outputs( task, currentOutputs );
+	if( currentOutputs.size() != it->second.size() )
+	{
+		return false;
+	}
+
+	for( size_t i = 0; i < currentOutputs.size(); ++i )
+	{
+		const Output &recorded = it->second[i];
+		const Output &current = currentOutputs[i];
+		if( current.fileName != recorded.fileName || current.modificationTime != recorded.modificationTime || current.modificationTime == -1 )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void ExecutionLedger::record( const ExecutableNode::Task &task )
+{
+	if( !task.node()->executionHashIsComplete() )
+	{
+		return;
+	}
+
+	const MurmurHash hash = task.hash();
+	if( hash == MurmurHash() )
+	{
+		return;
+	}
+
+	Outputs taskOutputs;
+	outputs( task, taskOutputs );
+
+	std::string line = hash.toString();
+	for( Outputs::const_iterator it = taskOutputs.begin(), eIt = taskOutputs.end(); it != eIt; ++it )
+	{
+		line += "\t" + boost::lexical_cast<std::string>( it->modificationTime ) + "\t" + it->fileName;
+	}
+	line += "\n";
+
+	tbb::mutex::scoped_lock lock( m_mutex );
+
+	// We open the file for each record, so that appends from other
+	// processes are interleaved a line at a time.
+	std::ofstream file( m_fileName.c_str(), std::ios::app );
+	if( !file.good() )
+	{
+		throw IOException( "Unable to open execution ledger \"" + m_fileName + "\"" );
+	}
+
+	file << line << std::flush;
+	m_records[hash.toString()].swap( taskOutputs );
+}
+
+void ExecutionLedger::outputs( const ExecutableNode::Task &task, Outputs &outputs )
+{
+	std::vector<std::string> fileNames;
+	task.node()->executionOutputs( task.context(), fileNames );
+
+	outputs.resize( fileNames.size() );
+	for( size_t i = 0; i < fileNames.size(); ++i )
+	{
+		outputs[i].fileName = fileNames[i];
+		boost::system::error_code error;
+		outputs[i].modificationTime = boost::filesystem::last_write_time( fileNames[i], error );
+		if( error )
+		{
+			outputs[i].modificationTime = -1;
+		}
+	}
+}
@@ -136,21 +136,19 @@ void Expression::hash( const ValuePlug *output, const Context *context, IECore::
 		{
 			in->hash( h );
 		}
-		if( m_engine )
+		// we only hash the context variables the expression actually
+		// reads, so that changes to others don't cause it to be
+		// executed again.
+		for( std::vector<IECore::InternedString>::const_iterator it = m_contextNames.begin(); it != m_contextNames.end(); it++ )
 		{
-			std::vector<std::string> contextNames;
-			m_engine->contextNames( contextNames );
-			for( std::vector<std::string>::const_iterator it = contextNames.begin(); it != contextNames.end(); it++ )
+			const IECore::Data *d = context->get<IECore::Data>( *it, 0 );
+			if( d )
 			{
-				const IECore::Data *d = context->get<IECore::Data>( *it, 0 );
-				if( d )
-				{
-					d->hash( h );
-				}
-				else
-				{
-					h.append( 0 );
-				}
+				d->hash( h );
+			}
+			else
+			{
+				h.append( 0 );
 			}
 		}
 	}
@@ -194,13 +192,13 @@ void Expression::plugSet( Plug *plug )
 	StringPlug *e = expressionPlug();
 	if( plug == e )
 	{
-		m_engine = 0;
+		setEngine( 0 );
 		
 		try {
 			std::string newExpression = e->getValue();
 			if( newExpression.size() )
 			{
-				m_engine = Engine::create( enginePlug()->getValue(), newExpression );
+				setEngine( Engine::create( enginePlug()->getValue(), newExpression ) );
 				
 				std::vector<std::string> inPlugPaths;
 				std::string outPlugPath;
@@ -218,7 +216,7 @@ void Expression::plugSet( Plug *plug )
 		{
 			/// \todo Report error to user somehow - error signal on Node?
 			IECore::msg( IECore::Msg::Error, "Expression::plugSet", e.what() );
-			m_engine = 0;
+			setEngine( 0 );
 		}
 		
 	}
@@ -234,7 +232,7 @@ void Expression::parentChanged( GraphComponent *child, GraphComponent *oldParent
 		std::string expression = expressionPlug()->getValue();
 		if( expression.size() )
 		{
-			m_engine = Engine::create( enginePlug()->getValue(), expression );	
+			setEngine( Engine::create( enginePlug()->getValue(), expression ) );
 		}
 	}
 }
@@ -286,6 +284,18 @@ void Expression::updatePlugs( const std::string &dstPlugPath, std::vector<std::s
 	dstPlug->setInput( outPlug );
 }
 
+void Expression::setEngine( EnginePtr engine )
+{
+	m_engine = engine;
+	m_contextNames.clear();
+	if( m_engine )
+	{
+		std::vector<std::string> contextNames;
+		m_engine->contextNames( contextNames );
+		m_contextNames.insert( m_contextNames.end(), contextNames.begin(), contextNames.end() );
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////
 // Expression::Engine implementation
 //////////////////////////////////////////////////////////////////////////
@@ -36,11 +36,13 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include <set>
+#include <map>
 
 #include "boost/format.hpp"
 #include "boost/bind.hpp"
 #include "boost/regex.hpp"
 #include "boost/lexical_cast.hpp"
+#include "boost/unordered_map.hpp"
 
 #include "IECore/Exception.h"
 
@@ -52,6 +54,123 @@ using namespace Gaffer;
 using namespace IECore;
 using namespace std;
 
+//////////////////////////////////////////////////////////////////////////
+// ChildIndex
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// The number of children at which we start maintaining a ChildIndex.
+const size_t g_childIndexThreshold = 16;
+
+// Splits a name into the prefix and numeric suffix used when making names
+// unique. Names without a numeric suffix are considered to have a suffix of 0,
+// which is consistent with the way siblings are treated by
+// GraphComponent::uniqueChildName().
+void splitName( const std::string &name, std::string &prefix, long &suffix )
+{
+	const size_t prefixSize = name.find_last_not_of( "0123456789" ) + 1;
+	prefix = name.substr( 0, prefixSize );
+	suffix = strtol( name.c_str() + prefixSize, 0, 10 );
+}
+
+} // namespace
+
+struct GraphComponent::ChildIndex
+{
+
+	ChildIndex( const ChildContainer &children )
+	{
+		for( ChildContainer::const_iterator it = children.begin(), eIt = children.end(); it != eIt; ++it )
+		{
+			insert( it->get() );
+		}
+	}
+
+	// InternedStrings have unique storage, so we can hash on the address of the string
+	// rather than its contents.
+	typedef boost::unordered_map<const char *, const GraphComponent *> NameMap;
+	NameMap names;
+
+	// For each prefix, the numeric suffixes of all children sharing that prefix. This
+	// allows unique names to be generated without visiting every sibling.
+	typedef std::map<std::string, std::multiset<long> > SuffixMap;
+	SuffixMap suffixes;
+
+	const GraphComponent *child( const IECore::InternedString &name ) const
+	{
+		NameMap::const_iterator it = names.find( name.c_str() );
+		return it != names.end() ? it->second : 0;
+	}
+
+	void insert( const GraphComponent *child )
+	{
+		names[child->m_name.c_str()] = child;
+
+		std::string prefix; long suffix;
+		splitName( child->m_name.value(), prefix, suffix );
+		suffixes[prefix].insert( suffix );
+	}
+
+	// Removes the entry for the child if it has one, returning true
+	// on success and false otherwise.
+	bool erase( const GraphComponent *child )
+	{
+		NameMap::iterator it = names.find( child->m_name.c_str() );
+		if( it == names.end() || it->second != child )
+		{
+			return false;
+		}
+		names.erase( it );
+
+		std::string prefix; long suffix;
+		splitName( child->m_name.value(), prefix, suffix );
+		SuffixMap::iterator sIt = suffixes.find( prefix );
+		sIt->second.erase( sIt->second.find( suffix ) );
+		if( sIt->second.empty() )
+		{
+			suffixes.erase( sIt );
+		}
+		return true;
+	}
+
+	// Returns the largest suffix used by any child with the specified prefix,
+	// ignoring the child specified by exclude. Returns false if there are no
+	// such children.
+	bool maxSuffix( const std::string &prefix, const GraphComponent *exclude, long &result ) const
+	{
+		SuffixMap::const_iterator sIt = suffixes.find( prefix );
+		if( sIt == suffixes.end() )
+		{
+			return false;
+		}
+
+		std::multiset<long>::const_reverse_iterator it = sIt->second.rbegin();
+		if( child( exclude->m_name ) == exclude )
+		{
+			std::string excludePrefix; long excludeSuffix;
+			splitName( exclude->m_name.value(), excludePrefix, excludeSuffix );
+			if( excludePrefix == prefix && *it == excludeSuffix && sIt->second.count( excludeSuffix ) == 1 )
+			{
+				++it;
+			}
+		}
+
+		if( it == sIt->second.rend() )
+		{
+			return false;
+		}
+		result = *it;
+		return true;
+	}
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// GraphComponent
+//////////////////////////////////////////////////////////////////////////
+
 IE_CORE_DEFINERUNTIMETYPED( GraphComponent );
 
 GraphComponent::GraphComponent( const std::string &name )
@@ -83,48 +202,7 @@ const IECore::InternedString &GraphComponent::setName( const IECore::InternedStr
 	}
 	
 	// make sure the name is unique
-	IECore::InternedString newName = name;
-	if( m_parent )
-	{
-		bool uniqueAlready = true;
-		for( ChildContainer::const_iterator it=m_parent->m_children.begin(), eIt=m_parent->m_children.end(); it != eIt; it++ )
-		{
-			if( *it != this && (*it)->m_name == m_name )
-			{
-				uniqueAlready = false;
-				break;
-			}
-		}
-	
-		if( !uniqueAlready )
-		{
-			// split name into a prefix and a numeric suffix. if no suffix
-			// exists then it defaults to 1.
-			std::string prefix;
-			int suffix = numericSuffix( newName.value(), 1, &prefix );
-
-			// iterate over all the siblings to find the minimum value for the suffix which
-			// will be greater than any existing suffix.
-			for( ChildContainer::const_iterator it=m_parent->m_children.begin(), eIt=m_parent->m_children.end(); it != eIt; it++ )
-			{
-				if( *it == this )
-				{
-					continue;
-				}
-				if( (*it)->m_name.value().compare( 0, prefix.size(), prefix ) == 0 )
-				{
-					char *endPtr = 0;
-					long siblingSuffix = strtol( (*it)->m_name.value().c_str() + prefix.size(), &endPtr, 10 );
-					if( *endPtr == '\0' )
-					{
-						suffix = max( suffix, (int)siblingSuffix + 1 );
-					}
-				}
-			}
-			static boost::format formatter( "%s%d" );
-			newName = boost::str( formatter % prefix % suffix );
-		}
-	}
+	IECore::InternedString newName = m_parent ? m_parent->uniqueChildName( this, name ) : name;
 	
 	// set the new name if it's different to the old
 	if( newName==m_name )
@@ -145,10 +223,82 @@ const IECore::InternedString &GraphComponent::setName( const IECore::InternedStr
 
 void GraphComponent::setNameInternal( const IECore::InternedString &name )
 {
+	ChildIndex *parentIndex = m_parent ? m_parent->m_childIndex.get() : 0;
+	const bool indexed = parentIndex && parentIndex->erase( this );
 	m_name = name;
+	if( indexed )
+	{
+		parentIndex->insert( this );
+	}
 	nameChangedSignal()( this );
 }
 
+IECore::InternedString GraphComponent::uniqueChildName( const GraphComponent *child, const IECore::InternedString &name ) const
+{
+	if( m_childIndex )
+	{
+		const GraphComponent *existingChild = m_childIndex->child( name );
+		if( !existingChild || existingChild == child )
+		{
+			return name;
+		}
+	}
+	else
+	{
+		bool uniqueAlready = true;
+		for( ChildContainer::const_iterator it=m_children.begin(), eIt=m_children.end(); it != eIt; it++ )
+		{
+			if( *it != child && (*it)->m_name == name )
+			{
+				uniqueAlready = false;
+				break;
+			}
+		}
+		if( uniqueAlready )
+		{
+			return name;
+		}
+	}
+	
+	// split name into a prefix and a numeric suffix. if no suffix
+	// exists then it defaults to 1.
+	std::string prefix;
+	int suffix = numericSuffix( name.value(), 1, &prefix );
+
+	// find the minimum value for the suffix which will be greater
+	// than any existing suffix.
+	if( m_childIndex )
+	{
+		long siblingSuffix = 0;
+		if( m_childIndex->maxSuffix( prefix, child, siblingSuffix ) )
+		{
+			suffix = max( suffix, (int)siblingSuffix + 1 );
+		}
+	}
+	else
+	{
+		for( ChildContainer::const_iterator it=m_children.begin(), eIt=m_children.end(); it != eIt; it++ )
+		{
+			if( *it == child )
+			{
+				continue;
+			}
+			if( (*it)->m_name.value().compare( 0, prefix.size(), prefix ) == 0 )
+			{
+				char *endPtr = 0;
+				long siblingSuffix = strtol( (*it)->m_name.value().c_str() + prefix.size(), &endPtr, 10 );
+				if( *endPtr == '\0' )
+				{
+					suffix = max( suffix, (int)siblingSuffix + 1 );
+				}
+			}
+		}
+	}
+	
+	static boost::format formatter( "%s%d" );
+	return boost::str( formatter % prefix % suffix );
+}
+
 const IECore::InternedString &GraphComponent::getName() const
 {
 	return m_name;
@@ -302,6 +452,14 @@ void GraphComponent::addChildInternal( GraphComponentPtr child )
 	m_children.push_back( child );
 	child->m_parent = this;
 	child->setName( child->m_name.value() ); // to force uniqueness
+	if( m_childIndex )
+	{
+		m_childIndex->insert( child.get() );
+	}
+	else if( m_children.size() >= g_childIndexThreshold )
+	{
+		m_childIndex.reset( new ChildIndex( m_children ) );
+	}
 	childAddedSignal()( this, child.get() );
 	child->parentChangedSignal()( child.get(), previousParent );
 }
@@ -363,6 +521,10 @@ void GraphComponent::removeChildInternal( GraphComponentPtr child, bool emitPare
 		throw Exception( boost::str( boost::format( "GraphComponent::removeChildInternal : \"%s\" is not a child of \"%s\"." ) % child->fullName() % fullName() ) );
 	}
 	m_children.erase( it );
+	if( m_childIndex )
+	{
+		m_childIndex->erase( child.get() );
+	}
 	child->m_parent = 0;
 	childRemovedSignal()( this, child.get() );
 	if( emitParentChanged )
@@ -376,6 +538,23 @@ const GraphComponent::ChildContainer &GraphComponent::children() const
 	return m_children;
 }
 
+const GraphComponent *GraphComponent::childInternal( const IECore::InternedString &name ) const
+{
+	if( m_childIndex )
+	{
+		return m_childIndex->child( name );
+	}
+	
+	for( ChildContainer::const_iterator it=m_children.begin(), eIt=m_children.end(); it!=eIt; it++ )
+	{
+		if( (*it)->m_name==name )
+		{
+			return it->get();
+		}
+	}
+	return 0;
+}
+
 GraphComponent *GraphComponent::ancestor( IECore::TypeId type )
 {
 	GraphComponent *a = m_parent;
@@ -0,0 +1,305 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2014, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#include "tbb/flow_graph.h"
+#include "tbb/task_scheduler_init.h"
+
+#include "boost/lexical_cast.hpp"
+#include "boost/shared_ptr.hpp"
+
+#include "IECore/MessageHandler.h"
+
+#include "Gaffer/Context.h"
+#include "Gaffer/ExecutionLedger.h"
+#include "Gaffer/InProcessDispatcher.h"
+
+using namespace IECore;
+using namespace Gaffer;
+
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// A group of Tasks for a single node, executed by a single call to
+// ExecutableNode::execute().
+struct Batch
+{
+
+	enum Status
+	{
+		Pending,
+		Completed,
+		Failed,
+		Skipped
+	};
+
+	Batch( const ExecutableNode *node )
+		:	node( node ), status( Pending )
+	{
+	}
+
+	const ExecutableNode *node;
+	ExecutableNode::Tasks tasks;
+	ExecutableNode::Contexts contexts;
+	std::set<size_t> requirements;
+	// Only written by the batch itself, and only read by the batches
+	// which require it, after it has completed.
+	Status status;
+
+};
+
+typedef std::vector<Batch> Batches;
+
+class BatchExecutor
+{
+
+	public :
+
+		BatchExecutor( Batches &batches, size_t index, ExecutionLedger *ledger, const std::string &messageContext )
+			:	m_batches( batches ), m_index( index ), m_ledger( ledger ), m_messageContext( messageContext )
+		{
+		}
+
+		tbb::flow::continue_msg operator()( const tbb::flow::continue_msg &continueMsg ) const
+		{
+			Batch &batch = m_batches[m_index];
+			for( std::set<size_t>::const_iterator it = batch.requirements.begin(), eIt = batch.requirements.end(); it != eIt; ++it )
+			{
+				if( m_batches[*it].status != Batch::Completed )
+				{
+					batch.status = Batch::Skipped;
+					return continueMsg;
+				}
+			}
+
+			try
+			{
+				batch.node->execute( batch.contexts );
+				batch.status = Batch::Completed;
+			}
+			catch( const std::exception &e )
+			{
+				batch.status = Batch::Failed;
+				msg( Msg::Error, m_messageContext, "Failed to execute " + batch.node->relativeName( batch.node->scriptNode() ) + " : " + e.what() );
+			}
+			catch( ... )
+			{
+				batch.status = Batch::Failed;
+				msg( Msg::Error, m_messageContext, "Failed to execute " + batch.node->relativeName( batch.node->scriptNode() ) + " : Unknown error" );
+			}
+
+			if( m_ledger && batch.status == Batch::Completed )
+			{
+				try
+				{
+					for( ExecutableNode::Tasks::const_iterator it = batch.tasks.begin(), eIt = batch.tasks.end(); it != eIt; ++it )
+					{
+						m_ledger->record( *it );
+					}
+				}
+				catch( const std::exception &e )
+				{
+					msg( Msg::Error, m_messageContext, std::string( "Failed to record execution : " ) + e.what() );
+				}
+			}
+
+			return continueMsg;
+		}
+
+	private :
+
+		Batches &m_batches;
+		size_t m_index;
+		ExecutionLedger *m_ledger;
+		const std::string &m_messageContext;
+
+};
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// InProcessDispatcher
+//////////////////////////////////////////////////////////////////////////
+
+IE_CORE_DEFINERUNTIMETYPED( InProcessDispatcher )
+
+size_t InProcessDispatcher::g_firstPlugIndex = 0;
+
+InProcessDispatcher::InProcessDispatcher( const std::string &name )
+	:	Dispatcher( name )
+{
+	storeIndexOfNextChild( g_firstPlugIndex );
+	addChild( new IntPlug( "framesPerBatch", Plug::In, 0, 0 ) );
+}
+
+InProcessDispatcher::~InProcessDispatcher()
+{
+}
+
+IntPlug *InProcessDispatcher::framesPerBatchPlug()
+{
+	return getChild<IntPlug>( g_firstPlugIndex );
+}
+
+const IntPlug *InProcessDispatcher::framesPerBatchPlug() const
+{
+	return getChild<IntPlug>( g_firstPlugIndex );
+}
+
+void InProcessDispatcher::doDispatch( const TaskDescriptions &taskDescriptions ) const
+{
+	// Group the tasks into batches. A task may only join an existing batch if
+	// all its requirements are in earlier batches, which guarantees that the
+	// batches can't depend on one another cyclically.
+
+	typedef std::map<const ExecutableNode *, size_t> NodeCounts;
+	NodeCounts numTasks;
+	for( TaskDescriptions::const_iterator it = taskDescriptions.begin(), eIt = taskDescriptions.end(); it != eIt; ++it )
+	{
+		numTasks[it->task.node()]++;
+	}
+
+	const size_t framesPerBatch = framesPerBatchPlug()->getValue();
+	const size_t numThreads = tbb::task_scheduler_init::default_num_threads();
+
+	Batches batches;
+	std::map<ExecutableNode::Task, size_t> taskBatches;
+	NodeCounts openBatches;
+	for( TaskDescriptions::const_iterator it = taskDescriptions.begin(), eIt = taskDescriptions.end(); it != eIt; ++it )
+	{
+		const ExecutableNode *node = it->task.node();
+		const size_t batchSize = framesPerBatch ? framesPerBatch : ( numTasks[node] + numThreads - 1 ) / numThreads;
+
+		NodeCounts::iterator openIt = openBatches.find( node );
+		bool canJoin = openIt != openBatches.end() && batches[openIt->second].contexts.size() < batchSize;
+		for( std::set<ExecutableNode::Task>::const_iterator rIt = it->requirements.begin(), reIt = it->requirements.end(); canJoin && rIt != reIt; ++rIt )
+		{
+			std::map<ExecutableNode::Task, size_t>::const_iterator bIt = taskBatches.find( *rIt );
+			canJoin = bIt != taskBatches.end() && bIt->second < openIt->second;
+		}
+
+		if( !canJoin )
+		{
+			openIt = openBatches.insert( NodeCounts::value_type( node, 0 ) ).first;
+			openIt->second = batches.size();
+			batches.push_back( Batch( node ) );
+		}
+
+		batches[openIt->second].tasks.push_back( it->task );
+		batches[openIt->second].contexts.push_back( it->task.context() );
+		taskBatches[it->task] = openIt->second;
+	}
+
+	for( TaskDescriptions::const_iterator it = taskDescriptions.begin(), eIt = taskDescriptions.end(); it != eIt; ++it )
+	{
+		Batch &batch = batches[taskBatches[it->task]];
+		for( std::set<ExecutableNode::Task>::const_iterator rIt = it->requirements.begin(), reIt = it->requirements.end(); rIt != reIt; ++rIt )
+		{
+			std::map<ExecutableNode::Task, size_t>::const_iterator bIt = taskBatches.find( *rIt );
+			if( bIt != taskBatches.end() && &batches[bIt->second] != &batch )
+			{
+				batch.requirements.insert( bIt->second );
+			}
+		}
+	}
+
+	// Build a flow graph mirroring the batch requirements, and execute it.
+
+	const std::string messageContext = getName().string();
+
+	ExecutionLedgerPtr ledger;
+	const std::string ledgerFileName = Context::current()->substitute( executionLedgerPlug()->getValue() );
+	if( !ledgerFileName.empty() )
+	{
+		ledger = new ExecutionLedger( ledgerFileName );
+	}
+
+	typedef tbb::flow::continue_node<tbb::flow::continue_msg> BatchNode;
+	tbb::flow::graph graph;
+	tbb::flow::broadcast_node<tbb::flow::continue_msg> start( graph );
+	std::vector<boost::shared_ptr<BatchNode> > batchNodes;
+	batchNodes.reserve( batches.size() );
+	for( size_t i = 0, e = batches.size(); i < e; ++i )
+	{
+		batchNodes.push_back( boost::shared_ptr<BatchNode>( new BatchNode( graph, BatchExecutor( batches, i, ledger.get(), messageContext ) ) ) );
+		const std::set<size_t> &requirements = batches[i].requirements;
+		if( requirements.empty() )
+		{
+			tbb::flow::make_edge( start, *batchNodes.back() );
+		}
+	}
+
+	for( size_t i = 0, e = batches.size(); i < e; ++i )
+	{
+		const std::set<size_t> &requirements = batches[i].requirements;
+		for( std::set<size_t>::const_iterator it = requirements.begin(), eIt = requirements.end(); it != eIt; ++it )
+		{
+			tbb::flow::make_edge( *batchNodes[*it], *batchNodes[i] );
+		}
+	}
+
+	start.try_put( tbb::flow::continue_msg() );
+	graph.wait_for_all();
+
+	size_t numFailed = 0;
+	size_t numSkipped = 0;
+	for( size_t i = 0, e = batches.size(); i < e; ++i )
+	{
+		if( batches[i].status == Batch::Failed )
+		{
+			numFailed += batches[i].contexts.size();
+		}
+		else if( batches[i].status == Batch::Skipped )
+		{
+			numSkipped += batches[i].contexts.size();
+		}
+	}
+
+	if( numFailed )
+	{
+		throw IECore::Exception(
+			messageContext + " : " + boost::lexical_cast<std::string>( numFailed ) + " tasks failed and " +
+			boost::lexical_cast<std::string>( numSkipped ) + " dependent tasks were skipped."
+		);
+	}
+}
+
+void InProcessDispatcher::doSetupPlugs( CompoundPlug *parentPlug ) const
+{
+}
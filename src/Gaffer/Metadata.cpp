@@ -38,6 +38,7 @@
 
 #include "boost/lambda/lambda.hpp"
 #include "boost/bind.hpp"
+#include "boost/functional/hash.hpp"
 
 #include "IECore/CompoundData.h"
 
@@ -86,22 +87,24 @@ CompoundData *instanceMetadata( const GraphComponent *instance, bool createIfMis
 {
 	InstanceMetadataMap &m = instanceMetadataMap();
 	
-	InstanceMetadataMap::accessor accessor;
-	if( m.find( accessor, instance ) )
-	{
-		return accessor->second.get();
-	}
-	else
+	if( !createIfMissing )
 	{
-		if( createIfMissing )
+		// a const_accessor takes only a reader lock, so concurrent
+		// queries don't serialise on the same bucket.
+		InstanceMetadataMap::const_accessor accessor;
+		if( m.find( accessor, instance ) )
 		{
-			m.insert( accessor, instance );
-			accessor->second = new CompoundData();
 			return accessor->second.get();
 		}
+		return NULL;
 	}
 	
-	return NULL;
+	InstanceMetadataMap::accessor accessor;
+	if( m.insert( accessor, instance ) )
+	{
+		accessor->second = new CompoundData();
+	}
+	return accessor->second.get();
 }
 
 const Data *instanceValue( const GraphComponent *instance, InternedString key )
@@ -155,6 +158,128 @@ void registerInstanceValue( GraphComponent *instance, IECore::InternedString key
 	);
 }
 
+// Searching for a plug value requires matching the plug path against every
+// pattern registered for the node type and each of its base types. That is
+// far too slow to do on every query, so we cache the function that the search
+// resolves to. Clearing the cache when a new plug value is registered would
+// not be safe while other threads are querying it, so instead we increment a
+// generation count, and treat any entry from an earlier generation as stale.
+struct PlugValueCacheKey
+{
+
+	PlugValueCacheKey( IECore::TypeId typeId, const std::string &plugPath, InternedString key, bool inherit )
+		:	typeId( typeId ), plugPath( plugPath ), key( key ), inherit( inherit )
+	{
+	}
+
+	IECore::TypeId typeId;
+	std::string plugPath;
+	InternedString key;
+	bool inherit;
+
+};
+
+struct PlugValueCacheHashCompare
+{
+
+	static size_t hash( const PlugValueCacheKey &k )
+	{
+		size_t result = 0;
+		boost::hash_combine( result, (int)k.typeId );
+		boost::hash_combine( result, k.plugPath );
+		boost::hash_combine( result, k.key.c_str() );
+		boost::hash_combine( result, k.inherit );
+		return result;
+	}
+
+	static bool equal( const PlugValueCacheKey &k1, const PlugValueCacheKey &k2 )
+	{
+		return
+			k1.typeId == k2.typeId &&
+			k1.key == k2.key &&
+			k1.inherit == k2.inherit &&
+			k1.plugPath == k2.plugPath
+		;
+	}
+
+};
+
+// Functions are pointers into the PlugValues held by the NodeMetadataMap, which
+// remain valid because registered values are never removed. NULL is stored
+// when the search found nothing.
+struct PlugValueCacheEntry
+{
+
+	size_t generation;
+	const Metadata::PlugValueFunction *function;
+
+};
+
+typedef concurrent_hash_map<PlugValueCacheKey, PlugValueCacheEntry, PlugValueCacheHashCompare> PlugValueCache;
+
+PlugValueCache &plugValueCache()
+{
+	static PlugValueCache c;
+	return c;
+}
+
+tbb::atomic<size_t> g_plugValueGeneration;
+
+const Metadata::PlugValueFunction *plugValueFunction( const PlugValueCacheKey &cacheKey )
+{
+	IECore::TypeId typeId = cacheKey.typeId;
+	while( typeId != InvalidTypeId )
+	{
+		NodeMetadataMap::const_iterator nIt = nodeMetadataMap().find( typeId );
+		if( nIt != nodeMetadataMap().end() )
+		{
+			NodeMetadata::PlugPathsToValues::const_iterator it, eIt;
+			for( it = nIt->second.plugPathsToValues.begin(), eIt = nIt->second.plugPathsToValues.end(); it != eIt; ++it )
+			{
+				if( match( cacheKey.plugPath, it->first ) )
+				{
+					NodeMetadata::PlugValues::const_iterator vIt = it->second.find( cacheKey.key );
+					if( vIt != it->second.end() )
+					{
+						return &(vIt->second);
+					}
+				}
+			}
+		}
+		typeId = cacheKey.inherit ? RunTimeTyped::baseTypeId( typeId ) : InvalidTypeId;
+	}
+	return NULL;
+}
+
+const Metadata::PlugValueFunction *cachedPlugValueFunction( const PlugValueCacheKey &cacheKey )
+{
+	PlugValueCache &cache = plugValueCache();
+	// We must read the generation before searching, so that if a
+	// registration happens during the search, our result is stored
+	// as stale rather than current.
+	const size_t generation = g_plugValueGeneration;
+	
+	PlugValueCache::const_accessor readAccessor;
+	if( cache.find( readAccessor, cacheKey ) && readAccessor->second.generation == generation )
+	{
+		return readAccessor->second.function;
+	}
+	readAccessor.release();
+	
+	const Metadata::PlugValueFunction *result = plugValueFunction( cacheKey );
+	
+	PlugValueCache::accessor writeAccessor;
+	if( cache.insert( writeAccessor, cacheKey ) || writeAccessor->second.generation < generation )
+	{
+		// Don't overwrite an entry stored by a thread which
+		// searched more recently than we did.
+		writeAccessor->second.generation = generation;
+		writeAccessor->second.function = result;
+	}
+	
+	return result;
+}
+
 void registeredInstanceValues( const GraphComponent *graphComponent, std::vector<IECore::InternedString> &keys )
 {
 	if( const CompoundData *im = instanceMetadata( graphComponent, false ) )
@@ -266,6 +391,7 @@ void Metadata::registerPlugValue( IECore::TypeId nodeTypeId, const MatchPattern
 	NodeMetadata &nodeMetadata = nodeMetadataMap()[nodeTypeId];
 	NodeMetadata::PlugValues &plugValues = nodeMetadata.plugPathsToValues[plugPath];
 	plugValues[key] = value;
+	++g_plugValueGeneration;
 	plugValueChangedSignal()( nodeTypeId, plugPath, key );
 }
 
@@ -330,30 +456,11 @@ IECore::ConstDataPtr Metadata::plugValueInternal( const Plug *plug, IECore::Inte
 		return NULL;
 	}
 	
-	const string plugPath = plug->relativeName( node );
+	const Metadata::PlugValueFunction *f = cachedPlugValueFunction(
+		PlugValueCacheKey( node->typeId(), plug->relativeName( node ), key, inherit )
+	);
 	
-	IECore::TypeId typeId = node->typeId();
-	while( typeId != InvalidTypeId )
-	{
-		NodeMetadataMap::const_iterator nIt = nodeMetadataMap().find( typeId );
-		if( nIt != nodeMetadataMap().end() )
-		{
-			NodeMetadata::PlugPathsToValues::const_iterator it, eIt;
-			for( it = nIt->second.plugPathsToValues.begin(), eIt = nIt->second.plugPathsToValues.end(); it != eIt; ++it )
-			{
-				if( match( plugPath, it->first ) )
-				{
-					NodeMetadata::PlugValues::const_iterator vIt = it->second.find( key );
-					if( vIt != it->second.end() )
-					{
-						return vIt->second( plug );
-					}
-				}
-			}
-		}
-		typeId = inherit ? RunTimeTyped::baseTypeId( typeId ) : InvalidTypeId;
-	}
-	return NULL;
+	return f ? (*f)( plug ) : NULL;
 }
 
 void Metadata::registerPlugDescription( IECore::TypeId nodeTypeId, const MatchPattern &plugPath, const std::string &description )
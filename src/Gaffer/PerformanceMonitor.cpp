@@ -0,0 +1,275 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2014, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include "boost/format.hpp"
+
+#include "tbb/spin_rw_mutex.h"
+
+#include "Gaffer/PerformanceMonitor.h"
+
+using namespace Gaffer;
+
+//////////////////////////////////////////////////////////////////////////
+// Statistics
+//////////////////////////////////////////////////////////////////////////
+
+PerformanceMonitor::Statistics::Statistics()
+	:	hashCount( 0 ), computeCount( 0 ), cacheHitCount( 0 ), totalComputeTime( 0.0 ), exclusiveComputeTime( 0.0 )
+{
+}
+
+PerformanceMonitor::Statistics &PerformanceMonitor::Statistics::operator += ( const Statistics &rhs )
+{
+	hashCount += rhs.hashCount;
+	computeCount += rhs.computeCount;
+	cacheHitCount += rhs.cacheHitCount;
+	totalComputeTime += rhs.totalComputeTime;
+	exclusiveComputeTime += rhs.exclusiveComputeTime;
+	return *this;
+}
+
+bool PerformanceMonitor::Statistics::operator == ( const Statistics &rhs ) const
+{
+	return
+		hashCount == rhs.hashCount &&
+		computeCount == rhs.computeCount &&
+		cacheHitCount == rhs.cacheHitCount &&
+		totalComputeTime == rhs.totalComputeTime &&
+		exclusiveComputeTime == rhs.exclusiveComputeTime;
+}
+
+bool PerformanceMonitor::Statistics::operator != ( const Statistics &rhs ) const
+{
+	return !( *this == rhs );
+}
+
+//////////////////////////////////////////////////////////////////////////
+// ThreadData
+//////////////////////////////////////////////////////////////////////////
+
+static tbb::atomic<size_t> g_threadDataCount;
+
+PerformanceMonitor::ThreadData::ThreadData()
+	:	id( g_threadDataCount++ )
+{
+}
+
+//////////////////////////////////////////////////////////////////////////
+// PerformanceMonitor
+//////////////////////////////////////////////////////////////////////////
+
+tbb::atomic<size_t> PerformanceMonitor::g_activeScopes;
+
+PerformanceMonitor::PerformanceMonitor( bool recordEvents )
+	:	m_recordEvents( recordEvents ), m_startTime( tbb::tick_count::now() )
+{
+}
+
+PerformanceMonitor::~PerformanceMonitor()
+{
+}
+
+PerformanceMonitor::StatisticsMap PerformanceMonitor::allStatistics() const
+{
+	StatisticsMap result;
+	for( ThreadSpecificData::const_iterator it = m_threadData.begin(), eIt = m_threadData.end(); it != eIt; ++it )
+	{
+		for( ThreadData::PlugStatistics::const_iterator sIt = it->statistics.begin(), sEIt = it->statistics.end(); sIt != sEIt; ++sIt )
+		{
+			result[sIt->second.first] += sIt->second.second;
+		}
+	}
+	return result;
+}
+
+PerformanceMonitor::Statistics PerformanceMonitor::plugStatistics( const ValuePlug *plug ) const
+{
+	Statistics result;
+	for( ThreadSpecificData::const_iterator it = m_threadData.begin(), eIt = m_threadData.end(); it != eIt; ++it )
+	{
+		ThreadData::PlugStatistics::const_iterator sIt = it->statistics.find( plug );
+		if( sIt != it->statistics.end() )
+		{
+			result += sIt->second.second;
+		}
+	}
+	return result;
+}
+
+PerformanceMonitor::Statistics PerformanceMonitor::combinedStatistics() const
+{
+	Statistics result;
+	for( ThreadSpecificData::const_iterator it = m_threadData.begin(), eIt = m_threadData.end(); it != eIt; ++it )
+	{
+		for( ThreadData::PlugStatistics::const_iterator sIt = it->statistics.begin(), sEIt = it->statistics.end(); sIt != sEIt; ++sIt )
+		{
+			result += sIt->second.second;
+		}
+	}
+	return result;
+}
+
+void PerformanceMonitor::writeChromeTrace( std::ostream &stream ) const
+{
+	stream << "{\n\"traceEvents\" : [\n";
+	
+	bool first = true;
+	for( ThreadSpecificData::const_iterator it = m_threadData.begin(), eIt = m_threadData.end(); it != eIt; ++it )
+	{
+		for( std::vector<Event>::const_iterator eventIt = it->events.begin(), eventEIt = it->events.end(); eventIt != eventEIt; ++eventIt )
+		{
+			if( !first )
+			{
+				stream << ",\n";
+			}
+			first = false;
+			
+			// Plug names are restricted to alphanumerics and underscores,
+			// so we don't need to escape them.
+			stream << boost::format( "\t{ \"name\" : \"%s\", \"cat\" : \"compute\", \"ph\" : \"X\", \"pid\" : 0, \"tid\" : %d, \"ts\" : %.3f, \"dur\" : %.3f }" )
+				% eventIt->plug->fullName()
+				% it->id
+				% ( eventIt->startTime * 1000000.0 )
+				% ( eventIt->duration * 1000000.0 );
+		}
+	}
+	
+	stream << "\n],\n\"displayTimeUnit\" : \"ms\"\n}\n";
+}
+
+void PerformanceMonitor::hashed( const ValuePlug *plug )
+{
+	statistics( m_threadData.local(), plug ).hashCount++;
+}
+
+void PerformanceMonitor::cacheHit( const ValuePlug *plug )
+{
+	statistics( m_threadData.local(), plug ).cacheHitCount++;
+}
+
+void PerformanceMonitor::computeStarted()
+{
+	m_threadData.local().upstreamComputeTimes.push_back( 0.0 );
+}
+
+void PerformanceMonitor::computeFinished( const ValuePlug *plug, const tbb::tick_count &startTime )
+{
+	const double duration = ( tbb::tick_count::now() - startTime ).seconds();
+	
+	ThreadData &threadData = m_threadData.local();
+	const double upstreamComputeTime = threadData.upstreamComputeTimes.back();
+	threadData.upstreamComputeTimes.pop_back();
+	if( threadData.upstreamComputeTimes.size() )
+	{
+		threadData.upstreamComputeTimes.back() += duration;
+	}
+	
+	Statistics &s = statistics( threadData, plug );
+	s.computeCount++;
+	s.totalComputeTime += duration;
+	s.exclusiveComputeTime += std::max( 0.0, duration - upstreamComputeTime );
+	
+	if( m_recordEvents )
+	{
+		Event event;
+		event.plug = plug;
+		event.startTime = ( startTime - m_startTime ).seconds();
+		event.duration = duration;
+		threadData.events.push_back( event );
+	}
+}
+
+PerformanceMonitor::Statistics &PerformanceMonitor::statistics( ThreadData &threadData, const ValuePlug *plug )
+{
+	ThreadData::PlugStatistics::iterator it = threadData.statistics.find( plug );
+	if( it == threadData.statistics.end() )
+	{
+		it = threadData.statistics.insert(
+			ThreadData::PlugStatistics::value_type( plug, std::make_pair( ConstValuePlugPtr( plug ), Statistics() ) )
+		).first;
+	}
+	return it->second.second;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Scope
+//////////////////////////////////////////////////////////////////////////
+
+// Scopes may be created and destroyed on any thread, and not necessarily
+// in a nested fashion, so we keep a list of all the live scopes rather than
+// have each scope restore a previous monitor. The most recently created
+// scope determines the active monitor.
+namespace
+{
+
+typedef tbb::spin_rw_mutex ScopesMutex;
+ScopesMutex g_scopesMutex;
+std::vector<PerformanceMonitor::Scope *> g_scopes;
+std::vector<PerformanceMonitorPtr> g_scopeMonitors;
+
+} // namespace
+
+PerformanceMonitor::Scope::Scope( PerformanceMonitorPtr monitor )
+	:	m_monitor( monitor )
+{
+	ScopesMutex::scoped_lock lock( g_scopesMutex, /* write = */ true );
+	g_scopes.push_back( this );
+	g_scopeMonitors.push_back( m_monitor );
+	g_activeScopes++;
+}
+
+PerformanceMonitor::Scope::~Scope()
+{
+	ScopesMutex::scoped_lock lock( g_scopesMutex, /* write = */ true );
+	std::vector<Scope *>::iterator it = std::find( g_scopes.begin(), g_scopes.end(), this );
+	g_scopeMonitors.erase( g_scopeMonitors.begin() + ( it - g_scopes.begin() ) );
+	g_scopes.erase( it );
+	g_activeScopes--;
+}
+
+PerformanceMonitorPtr PerformanceMonitor::activeMonitor()
+{
+	// we return a reference counted pointer so that the monitor can't be
+	// destroyed by another thread while the caller is using it.
+	ScopesMutex::scoped_lock lock( g_scopesMutex, /* write = */ false );
+	if( g_scopeMonitors.empty() )
+	{
+		return NULL;
+	}
+	return g_scopeMonitors.back();
+}
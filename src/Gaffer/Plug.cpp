@@ -201,6 +201,10 @@ void Plug::setInput( PlugPtr input )
 
 void Plug::setInputInternal( PlugPtr input, bool emit )
 {
+	// affects() may depend on connections, so
+	// the cached results are no longer valid.
+	DependencyNode::invalidateAffectsTables();
+	
 	if( m_input )
 	{
 		m_input->m_outputs.remove( this );
@@ -252,5 +256,11 @@ void Plug::parentChanging( Gaffer::GraphComponent *newParent )
 		removeOutputs();
 	}
 
+	// affects() may depend on the plugs a node has, so the cached results
+	// will be invalid once our parent has changed. we do this last because
+	// the disconnections above will have propagated dirtiness using the
+	// current tables.
+	DependencyNode::invalidateAffectsTables();
+
 }
 
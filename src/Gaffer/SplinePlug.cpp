@@ -186,6 +186,29 @@ T SplinePlug<T>::getValue() const
 	return result;
 }
 
+template<typename T>
+typename SplinePlug<T>::ConstLUTPtr SplinePlug<T>::getLUT() const
+{
+	const IECore::MurmurHash h = hash();
+	{
+		tbb::spin_mutex::scoped_lock lock( m_lutMutex );
+		if( m_lut && m_lutHash == h )
+		{
+			return m_lut;
+		}
+	}
+	
+	// build the LUT outside the lock, as it involves many
+	// evaluations of the spline. if several threads race to
+	// do this, they'll all produce equivalent results.
+	ConstLUTPtr lut( new LUT( getValue() ) );
+	
+	tbb::spin_mutex::scoped_lock lock( m_lutMutex );
+	m_lut = lut;
+	m_lutHash = h;
+	return lut;
+}
+
 template<typename T>
 CompoundPlug *SplinePlug<T>::basisPlug()
 {
@@ -36,21 +36,454 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include <stack>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+
+// Needed for task_arena in our version of TBB.
+#define TBB_PREVIEW_TASK_ARENA 1
 
 #include "tbb/enumerable_thread_specific.h"
+#include "tbb/atomic.h"
+#include "tbb/concurrent_hash_map.h"
+#include "tbb/spin_mutex.h"
+#include "tbb/tick_count.h"
+#include "tbb/task_arena.h"
+#include "tbb/concurrent_queue.h"
+#include "tbb/task_scheduler_init.h"
 
 #include "boost/bind.hpp"
 #include "boost/format.hpp"
+#include "boost/shared_ptr.hpp"
+#include "boost/noncopyable.hpp"
+#include "boost/thread/mutex.hpp"
+#include "boost/thread/condition_variable.hpp"
+#include "boost/multi_index_container.hpp"
+#include "boost/multi_index/hashed_index.hpp"
+#include "boost/multi_index/ordered_index.hpp"
+#include "boost/multi_index/member.hpp"
 
+#include "IECore/Exception.h"
 #include "IECore/LRUCache.h"
 
 #include "Gaffer/ValuePlug.h"
 #include "Gaffer/ComputeNode.h"
 #include "Gaffer/Context.h"
 #include "Gaffer/Action.h"
+#include "Gaffer/PerformanceMonitor.h"
 
 using namespace Gaffer;
 
+//////////////////////////////////////////////////////////////////////////
+// ValueCache implementation
+// A single cache would serialise all threads on its lock, so we split the
+// cache into a number of independent shards, choosing the shard for each
+// entry from the bits of its hash. The memory limit applies to the cache
+// as a whole rather than to the individual shards, so the cost of the
+// entries is accounted globally, and any single value smaller than the
+// limit may be cached.
+//
+// Each shard orders its entries by a priority determined by the eviction
+// policy, and when the limit is exceeded we evict the lowest priority entry
+// from whichever shard holds it. For LeastRecentlyUsed the priority is
+// simply the time of last access. For CostAware we use the GreedyDual-Size
+// algorithm, where the priority is the compute time per byte plus an
+// "inflation" value which is raised to the priority of each evicted entry,
+// so that entries which are not accessed gradually age out. Both the clock
+// and the inflation are shared by all shards, so that priorities may be
+// compared between them.
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+class ValueCache : boost::noncopyable
+{
+
+	public :
+	
+		ValueCache( size_t maxCost )
+			:	m_policy( ValuePlug::LeastRecentlyUsed ), m_epoch( tbb::tick_count::now() )
+		{
+			m_maxCost = maxCost;
+			m_currentCost = 0;
+			setInflation( 0 );
+			for( size_t i = 0; i < numShards; ++i )
+			{
+				m_shards.push_back( ShardPtr( new Shard( this ) ) );
+			}
+		}
+		
+		IECore::ConstObjectPtr get( const IECore::MurmurHash &hash )
+		{
+			return shard( hash ).get( hash );
+		}
+		
+		void set( const IECore::MurmurHash &hash, IECore::ConstObjectPtr value, size_t cost, double computeTime, ValuePlug::CachePolicy cachePolicy )
+		{
+			if( cost > m_maxCost )
+			{
+				return;
+			}
+			
+			if( shard( hash ).insert( hash, value, cost, computeTime, cachePolicy ) )
+			{
+				limitCost();
+			}
+		}
+		
+		size_t getMaxCost() const
+		{
+			return m_maxCost;
+		}
+		
+		void setMaxCost( size_t maxCost )
+		{
+			m_maxCost = maxCost;
+			limitCost();
+		}
+		
+		size_t currentCost() const
+		{
+			return m_currentCost;
+		}
+		
+		size_t currentCost( ValuePlug::CachePolicy cachePolicy ) const
+		{
+			size_t result = 0;
+			for( Shards::const_iterator it = m_shards.begin(), eIt = m_shards.end(); it != eIt; ++it )
+			{
+				result += (*it)->cachePolicyCosts[cachePolicy];
+			}
+			return result;
+		}
+		
+		ValuePlug::CacheEvictionPolicy getPolicy() const
+		{
+			return m_policy;
+		}
+		
+		void setPolicy( ValuePlug::CacheEvictionPolicy policy )
+		{
+			if( policy == m_policy )
+			{
+				return;
+			}
+			m_policy = policy;
+			setInflation( 0 );
+			for( Shards::const_iterator it = m_shards.begin(), eIt = m_shards.end(); it != eIt; ++it )
+			{
+				(*it)->reprioritise();
+			}
+		}
+		
+		ValuePlug::CacheStatistics statistics( size_t shardIndex ) const
+		{
+			if( shardIndex >= numShards )
+			{
+				throw IECore::Exception( boost::str( boost::format( "Cache shard index %d out of range" ) % shardIndex ) );
+			}
+			const Shard &s = *m_shards[shardIndex];
+			ValuePlug::CacheStatistics result;
+			result.hits = s.hits;
+			result.misses = s.misses;
+			result.evictions = s.evictions;
+			result.memoryUsage = s.currentCost;
+			return result;
+		}
+		
+		void resetStatistics()
+		{
+			for( Shards::const_iterator it = m_shards.begin(), eIt = m_shards.end(); it != eIt; ++it )
+			{
+				(*it)->hits = 0;
+				(*it)->misses = 0;
+				(*it)->evictions = 0;
+			}
+		}
+		
+		static const size_t numShards = 16;
+		
+	private :
+	
+		static const size_t numCachePolicies = ValuePlug::CachedInPool + 1;
+	
+		struct Entry
+		{
+		
+			Entry( const IECore::MurmurHash &hash, IECore::ConstObjectPtr value, size_t cost, double computeTime, ValuePlug::CachePolicy cachePolicy )
+				:	hash( hash ), value( value ), cost( cost ), computeTime( computeTime ), priority( 0 ), cachePolicy( cachePolicy )
+			{
+			}
+		
+			IECore::MurmurHash hash;
+			IECore::ConstObjectPtr value;
+			size_t cost;
+			double computeTime;
+			double priority;
+			ValuePlug::CachePolicy cachePolicy;
+			
+		};
+		
+		struct SetPriority
+		{
+			SetPriority( double priority ) : m_priority( priority ) {}
+			void operator()( Entry &e ) const { e.priority = m_priority; }
+			double m_priority;
+		};
+		
+		struct HashHasher
+		{
+			size_t operator()( const IECore::MurmurHash &h ) const
+			{
+				return tbb::tbb_hash_compare<IECore::MurmurHash>::hash( h );
+			}
+		};
+		
+		typedef boost::multi_index::multi_index_container<
+			Entry,
+			boost::multi_index::indexed_by<
+				boost::multi_index::hashed_unique<
+					boost::multi_index::member<Entry, IECore::MurmurHash, &Entry::hash>,
+					HashHasher
+				>,
+				boost::multi_index::ordered_non_unique<
+					boost::multi_index::member<Entry, double, &Entry::priority>
+				>
+			>
+		> Entries;
+		
+		typedef Entries::nth_index<0>::type HashIndex;
+		typedef Entries::nth_index<1>::type PriorityIndex;
+		
+		struct Shard
+		{
+		
+			Shard( ValueCache *cache )
+				:	cache( cache ), currentCost( 0 )
+			{
+				hits = 0;
+				misses = 0;
+				evictions = 0;
+				std::fill( cachePolicyCosts, cachePolicyCosts + numCachePolicies, 0 );
+			}
+			
+			IECore::ConstObjectPtr get( const IECore::MurmurHash &hash )
+			{
+				Mutex::scoped_lock lock( mutex );
+				HashIndex::iterator it = entries.find( hash );
+				if( it == entries.end() )
+				{
+					++misses;
+					return NULL;
+				}
+				
+				++hits;
+				entries.modify( it, SetPriority( cache->priority( *it ) ) );
+				return it->value;
+			}
+			
+			// Returns false if an entry already existed for the hash.
+			bool insert( const IECore::MurmurHash &hash, IECore::ConstObjectPtr value, size_t cost, double computeTime, ValuePlug::CachePolicy cachePolicy )
+			{
+				Mutex::scoped_lock lock( mutex );
+				
+				HashIndex::iterator it = entries.find( hash );
+				if( it != entries.end() )
+				{
+					// value was computed concurrently by another
+					// thread. keep the existing entry.
+					return false;
+				}
+				
+				Entry entry( hash, value, cost, computeTime, cachePolicy );
+				entry.priority = cache->priority( entry );
+				entries.insert( entry );
+				currentCost += cost;
+				cachePolicyCosts[cachePolicy] += cost;
+				// we update the global cost while holding our lock, so that
+				// it can't be decremented by an eviction before it has been
+				// incremented.
+				cache->m_currentCost += cost;
+				
+				return true;
+			}
+			
+			// Returns false if the shard is empty.
+			bool lowestPriority( double &priority )
+			{
+				Mutex::scoped_lock lock( mutex );
+				const PriorityIndex &priorityIndex = entries.get<1>();
+				if( priorityIndex.empty() )
+				{
+					return false;
+				}
+				priority = priorityIndex.begin()->priority;
+				return true;
+			}
+			
+			// Evicts the lowest priority entry, if there is one, transferring
+			// the value to evicted so it can be destroyed after the lock has
+			// been released.
+			void evict( std::vector<IECore::ConstObjectPtr> &evicted )
+			{
+				Mutex::scoped_lock lock( mutex );
+				PriorityIndex &priorityIndex = entries.get<1>();
+				if( priorityIndex.empty() )
+				{
+					return;
+				}
+				
+				PriorityIndex::iterator it = priorityIndex.begin();
+				if( cache->m_policy == ValuePlug::CostAware )
+				{
+					cache->raiseInflation( it->priority );
+				}
+				evicted.push_back( it->value );
+				currentCost -= it->cost;
+				cachePolicyCosts[it->cachePolicy] -= it->cost;
+				cache->m_currentCost -= it->cost;
+				priorityIndex.erase( it );
+				++evictions;
+			}
+			
+			void reprioritise()
+			{
+				Mutex::scoped_lock lock( mutex );
+				
+				// reassign priorities in the existing order, so that
+				// the most recently used entries are still favoured.
+				std::vector<IECore::MurmurHash> order;
+				order.reserve( entries.size() );
+				const PriorityIndex &priorityIndex = entries.get<1>();
+				for( PriorityIndex::const_iterator it = priorityIndex.begin(), eIt = priorityIndex.end(); it != eIt; ++it )
+				{
+					order.push_back( it->hash );
+				}
+				
+				for( std::vector<IECore::MurmurHash>::const_iterator it = order.begin(), eIt = order.end(); it != eIt; ++it )
+				{
+					HashIndex::iterator eit = entries.find( *it );
+					entries.modify( eit, SetPriority( cache->priority( *eit ) ) );
+				}
+			}
+			
+			ValueCache *cache;
+			
+			typedef tbb::spin_mutex Mutex;
+			Mutex mutex;
+			Entries entries;
+			size_t currentCost;
+			size_t cachePolicyCosts[numCachePolicies];
+			
+			tbb::atomic<size_t> hits;
+			tbb::atomic<size_t> misses;
+			tbb::atomic<size_t> evictions;
+			
+		};
+		
+		typedef boost::shared_ptr<Shard> ShardPtr;
+		typedef std::vector<ShardPtr> Shards;
+		
+		Shard &shard( const IECore::MurmurHash &hash )
+		{
+			// the shard's hash index uses the low bits of the hash to
+			// choose a bucket, so we use the high bits to choose a shard.
+			// this avoids every entry in a shard landing in the same subset
+			// of buckets.
+			const size_t h = tbb::tbb_hash_compare<IECore::MurmurHash>::hash( hash );
+			return *m_shards[ ( h >> ( sizeof( size_t ) * 8 - 8 ) ) % numShards ];
+		}
+		
+		double priority( const Entry &entry ) const
+		{
+			if( m_policy == ValuePlug::CostAware )
+			{
+				return inflation() + entry.computeTime / (double)std::max( entry.cost, (size_t)1 );
+			}
+			return ( tbb::tick_count::now() - m_epoch ).seconds();
+		}
+		
+		// Evicts the globally lowest priority entries until we're within
+		// the limit. No two shard locks are ever held at once.
+		void limitCost()
+		{
+			std::vector<IECore::ConstObjectPtr> evicted;
+			while( m_currentCost > m_maxCost )
+			{
+				Shard *victim = NULL;
+				double lowest = 0;
+				for( Shards::const_iterator it = m_shards.begin(), eIt = m_shards.end(); it != eIt; ++it )
+				{
+					double p;
+					if( (*it)->lowestPriority( p ) && ( !victim || p < lowest ) )
+					{
+						victim = it->get();
+						lowest = p;
+					}
+				}
+				
+				if( !victim )
+				{
+					break;
+				}
+				victim->evict( evicted );
+			}
+		}
+		
+		// The inflation is read by every shard, so we store it atomically
+		// as the bit pattern of a double.
+		double inflation() const
+		{
+			const uint64_t bits = m_inflation;
+			double result;
+			memcpy( &result, &bits, sizeof( result ) );
+			return result;
+		}
+		
+		void setInflation( double inflation )
+		{
+			uint64_t bits;
+			memcpy( &bits, &inflation, sizeof( bits ) );
+			m_inflation = bits;
+		}
+		
+		void raiseInflation( double inflation )
+		{
+			uint64_t bits;
+			memcpy( &bits, &inflation, sizeof( bits ) );
+			uint64_t currentBits = m_inflation;
+			while( true )
+			{
+				double current;
+				memcpy( &current, &currentBits, sizeof( current ) );
+				if( current >= inflation )
+				{
+					return;
+				}
+				const uint64_t previousBits = m_inflation.compare_and_swap( bits, currentBits );
+				if( previousBits == currentBits )
+				{
+					return;
+				}
+				currentBits = previousBits;
+			}
+		}
+		
+		ValuePlug::CacheEvictionPolicy m_policy;
+		const tbb::tick_count m_epoch;
+		tbb::atomic<size_t> m_maxCost;
+		tbb::atomic<size_t> m_currentCost;
+		tbb::atomic<uint64_t> m_inflation;
+		Shards m_shards;
+		
+};
+
+const size_t ValueCache::numShards;
+const size_t ValueCache::numCachePolicies;
+
+} // namespace
+
 //////////////////////////////////////////////////////////////////////////
 // Computation implementation
 // The computation class is responsible for managing the transient storage
@@ -66,7 +499,7 @@ class ValuePlug::Computation
 	public :
 	
 		Computation( const ValuePlug *resultPlug )
-			:	m_resultPlug( resultPlug ), m_resultValue( NULL )
+			:	m_resultPlug( resultPlug ), m_resultValue( NULL ), m_cachePolicy( Uncached ), m_computeTimeThreshold( 0 ), m_cache( NULL )
 		{
 			g_threadComputations.local().push( this );
 		}
@@ -83,38 +516,32 @@ class ValuePlug::Computation
 
 		IECore::ConstObjectPtr compute()
 		{
-			// decide whether or not to use the cache. even if
-			// the result plug has the Cacheable flag set, we disable
-			// caching if it gets its value from a direct input which
-			// does not have the Cacheable flag set.
-			bool cacheable = true;
-			const ValuePlug *p = m_resultPlug;
-			while( p )
+			m_cachePolicy = cachePolicy( m_computeTimeThreshold );
+			if( m_cachePolicy == Uncached )
 			{
-				if( !p->getFlags( Plug::Cacheable ) )
-				{
-					cacheable = false;
-					break;
-				}
-				p = p->getInput<ValuePlug>();
+				// we compute from scratch every time.
+				computeOrSetFromInput();
+				return m_resultValue;
 			}
-						
-			// do the cache lookup/computation.						
-			if( cacheable )
+			
+			// do the cache lookup/computation.
+			m_cache = m_cachePolicy == CachedInPool ? &g_poolCache : &g_valueCache;
+			IECore::MurmurHash hash = m_resultPlug->hash();
+			m_resultValue = m_cache->get( hash );
+			if( m_resultValue )
 			{
-				IECore::MurmurHash hash = m_resultPlug->hash();
-				m_resultValue = g_valueCache.get( hash );
-				if( !m_resultValue )
-				{
-					computeOrSetFromInput();
-					g_valueCache.set( hash, m_resultValue, m_resultValue->memoryUsage() );
-				}
+				PerformanceMonitor::recordCacheHit( m_resultPlug );
 			}
 			else
 			{
-				// plug has requested no caching, so we compute from scratch every
-				// time.
-				computeOrSetFromInput();
+				if( shareComputation() )
+				{
+					computeShared( hash );
+				}
+				else
+				{
+					computeAndCache( hash );
+				}
 			}
 			
 			return m_resultValue;
@@ -161,8 +588,333 @@ class ValuePlug::Computation
 			return g_valueCache.currentCost();
 		}
 		
+		static size_t cacheMemoryUsage( CachePolicy policy )
+		{
+			switch( policy )
+			{
+				case Cached :
+				case CachedIfExpensive :
+					return g_valueCache.currentCost( policy );
+				case CachedInPool :
+					return g_poolCache.currentCost();
+				default :
+					return 0;
+			}
+		}
+		
+		static size_t getCachePoolMemoryLimit()
+		{
+			return g_poolCache.getMaxCost();
+		}
+		
+		static void setCachePoolMemoryLimit( size_t bytes )
+		{
+			g_poolCache.setMaxCost( bytes );
+		}
+		
+		static size_t getCacheComputeTimeThreshold()
+		{
+			return g_cacheComputeTimeThreshold;
+		}
+		
+		static void setCacheComputeTimeThreshold( size_t microseconds )
+		{
+			g_cacheComputeTimeThreshold = microseconds;
+		}
+		
+		static size_t numCacheShards()
+		{
+			return ValueCache::numShards;
+		}
+		
+		static CacheEvictionPolicy getCacheEvictionPolicy()
+		{
+			return g_valueCache.getPolicy();
+		}
+		
+		static void setCacheEvictionPolicy( CacheEvictionPolicy policy )
+		{
+			g_valueCache.setPolicy( policy );
+			g_poolCache.setPolicy( policy );
+		}
+		
+		static CacheStatistics cacheStatistics( size_t shard )
+		{
+			return g_valueCache.statistics( shard );
+		}
+		
+		static CacheStatistics cachePoolStatistics( size_t shard )
+		{
+			return g_poolCache.statistics( shard );
+		}
+		
+		static void resetCacheStatistics()
+		{
+			g_valueCache.resetStatistics();
+			g_poolCache.resetStatistics();
+		}
+		
 	private :
 	
+		// Decides how our result should be cached. The Cacheable flag takes
+		// precedence, so caching is disabled if the result plug or any plug
+		// in its input chain doesn't have the flag set. Otherwise we use the
+		// policy of the node which ultimately computes the value, which
+		// also supplies the threshold for the CachedIfExpensive policy.
+		CachePolicy cachePolicy( size_t &computeTimeThreshold ) const
+		{
+			computeTimeThreshold = g_cacheComputeTimeThreshold;
+			const ValuePlug *p = m_resultPlug;
+			while( true )
+			{
+				if( !p->getFlags( Plug::Cacheable ) )
+				{
+					return Uncached;
+				}
+				const ValuePlug *input = p->getInput<ValuePlug>();
+				if( !input )
+				{
+					break;
+				}
+				p = input;
+			}
+			
+			if( p->direction() == Plug::Out )
+			{
+				if( const ComputeNode *n = p->ancestor<ComputeNode>() )
+				{
+					const CachePolicy result = n->cachePolicy( p );
+					if( result == CachedIfExpensive )
+					{
+						computeTimeThreshold = n->cacheComputeTimeThreshold( p );
+					}
+					return result;
+				}
+			}
+			
+			return Cached;
+		}
+		
+		// Returns true if concurrent computations of our result should be
+		// shared between threads, rather than being performed redundantly
+		// by each thread.
+		bool shareComputation() const
+		{
+			if( m_resultPlug->getInput<ValuePlug>() )
+			{
+				// setFrom() is cheap, and we'll be sharing
+				// the computation of the input anyway.
+				return false;
+			}
+			const ComputeNode *n = m_resultPlug->ancestor<ComputeNode>();
+			return n && n->shareComputations( m_resultPlug );
+		}
+
+		// Computes m_resultValue and stores it in the cache, taking care
+		// that only one thread at a time performs the computation for any
+		// given hash. Other threads requesting the same value wait for the
+		// first to complete and then share its result.
+		void computeShared( const IECore::MurmurHash &hash )
+		{
+			InFlightComputationPtr inFlight;
+			bool owner = false;
+			{
+				InFlightComputations::accessor a;
+				if( g_inFlightComputations.insert( a, hash ) )
+				{
+					a->second.reset( new InFlightComputation );
+					owner = true;
+				}
+				inFlight = a->second;
+			}
+			
+			if( !owner )
+			{
+				// Another thread is computing the value for us, so we wait for
+				// it. This is safe because the owning thread performs the
+				// computation within its own isolated task arena (see below),
+				// so it can never be waiting on a task which is stuck beneath
+				// us on this thread's stack. We remain conservative and don't
+				// wait if this thread owns an in-flight computation itself,
+				// because we can't cheaply rule out that the value we want
+				// depends on the one we're computing.
+				if( !g_threadOwnedComputations.local() )
+				{
+					m_resultValue = inFlight->wait();
+				}
+				if( !m_resultValue )
+				{
+					// Either we couldn't wait or the other thread failed to
+					// compute the value. Fall back to doing the work ourselves.
+					computeAndCache( hash );
+				}
+				return;
+			}
+			
+			// Any TBB tasks spawned by the computation must be executed in an
+			// isolated arena. Otherwise, threads waiting on those tasks - either
+			// ourselves or workers which have stolen subtasks and are themselves
+			// waiting on nested parallel work - could steal unrelated outer tasks,
+			// some of which may end up waiting on this very computation. Isolation
+			// guarantees that nothing we wait for can depend on our own result.
+			size_t &ownedComputations = g_threadOwnedComputations.local();
+			ownedComputations++;
+			IsolatedComputeAndCache isolatedComputeAndCache( this, hash );
+			tbb::task_arena *arena = acquireArena();
+			arena->execute( isolatedComputeAndCache );
+			releaseArena( arena );
+			ownedComputations--;
+			
+			// The value is already in the cache (if it is cacheable) by now, so
+			// new requests will find it there rather than starting a new computation.
+			g_inFlightComputations.erase( hash );
+			inFlight->finish( m_resultValue );
+			
+			isolatedComputeAndCache.rethrow();
+		}
+		
+		// Holds a copy of an exception so that it can be rethrown with its
+		// original type. We don't have std::exception_ptr, and neither
+		// boost::exception_ptr nor tbb::captured_exception preserve the
+		// type of exceptions they don't know about.
+		struct CapturedException
+		{
+			virtual ~CapturedException() {}
+			virtual void rethrow() const = 0;
+		};
+		
+		template<typename T>
+		struct TypedCapturedException : public CapturedException
+		{
+			TypedCapturedException( const T &e ) : exception( e ) {}
+			virtual void rethrow() const { throw exception; }
+			T exception;
+		};
+		
+		// Functor used to call computeAndCache() from within a task_arena.
+		// Exceptions are not propagated out of task_arena::execute(), so we
+		// capture them here for rethrowing by computeShared().
+		struct IsolatedComputeAndCache
+		{
+		
+			IsolatedComputeAndCache( Computation *computation, const IECore::MurmurHash &hash )
+				:	m_computation( computation ), m_hash( hash )
+			{
+			}
+			
+			void operator()()
+			{
+				try
+				{
+					m_computation->computeAndCache( m_hash );
+				}
+				// Most specific types first, so that they aren't
+				// sliced by the handlers for their base classes.
+				catch( const IECore::IOException &e )
+				{
+					capture( e );
+				}
+				catch( const IECore::InvalidArgumentException &e )
+				{
+					capture( e );
+				}
+				catch( const IECore::PermissionDeniedException &e )
+				{
+					capture( e );
+				}
+				catch( const IECore::NotImplementedException &e )
+				{
+					capture( e );
+				}
+				catch( const IECore::Exception &e )
+				{
+					capture( e );
+				}
+				catch( const std::bad_alloc &e )
+				{
+					capture( e );
+				}
+				catch( const std::exception &e )
+				{
+					// Copying a std::exception would lose the message,
+					// so we translate it.
+					capture( IECore::Exception( e.what() ) );
+				}
+				catch( ... )
+				{
+					capture( IECore::Exception( "Unknown error" ) );
+				}
+			}
+			
+			// Rethrows the exception thrown by computeAndCache(),
+			// if there was one.
+			void rethrow() const
+			{
+				if( m_exception )
+				{
+					m_exception->rethrow();
+				}
+			}
+			
+			private :
+			
+				template<typename T>
+				void capture( const T &e )
+				{
+					m_exception.reset( new TypedCapturedException<T>( e ) );
+					m_computation->m_resultValue = NULL;
+				}
+			
+				Computation *m_computation;
+				const IECore::MurmurHash &m_hash;
+				boost::shared_ptr<CapturedException> m_exception;
+				
+		};
+
+		// Initialising a task_arena is relatively expensive, and we need one
+		// for every shared computation, so we keep a pool of arenas for reuse.
+		// An arena is only ever used by one computation at a time, so reuse
+		// doesn't compromise isolation. The number of arenas in use at once
+		// is bounded only by the number of concurrent shared computations,
+		// so we limit the size of the pool and destroy any arenas beyond
+		// that, rather than holding on to the high water mark forever.
+		static tbb::task_arena *acquireArena()
+		{
+			tbb::task_arena *result;
+			if( g_arenaPool.try_pop( result ) )
+			{
+				--g_arenaPoolSize;
+				return result;
+			}
+			return new tbb::task_arena;
+		}
+		
+		static void releaseArena( tbb::task_arena *arena )
+		{
+			static const size_t maxPoolSize = 2 * tbb::task_scheduler_init::default_num_threads();
+			if( ++g_arenaPoolSize > maxPoolSize )
+			{
+				--g_arenaPoolSize;
+				delete arena;
+				return;
+			}
+			g_arenaPool.push( arena );
+		}
+		
+		// Fills in m_resultValue by calling computeOrSetFromInput(), and stores it
+		// in the cache along with the time taken to compute it.
+		void computeAndCache( const IECore::MurmurHash &hash )
+		{
+			const tbb::tick_count startTime = tbb::tick_count::now();
+			computeOrSetFromInput();
+			const double computeTime = ( tbb::tick_count::now() - startTime ).seconds();
+			if( m_cachePolicy == CachedIfExpensive && computeTime * 1000000.0 < (double)m_computeTimeThreshold )
+			{
+				return;
+			}
+			m_cache->set( hash, m_resultValue, m_resultValue->memoryUsage(), computeTime, m_cachePolicy );
+		}
+
 		// Fills in m_resultValue by calling ComputeNode::compute() or ValuePlug::setFrom().
 		// Throws if the result was not successfully retrieved.
 		void computeOrSetFromInput()
@@ -180,6 +932,7 @@ class ValuePlug::Computation
 				{
 					throw IECore::Exception( boost::str( boost::format( "Unable to compute value for Plug \"%s\" as it has no ComputeNode." ) % m_resultPlug->fullName() ) );			
 				}
+				PerformanceMonitor::ComputeScope monitorScope( m_resultPlug );
 				// cast is ok - see comment above.
 				n->compute( const_cast<ValuePlug *>( m_resultPlug ), Context::current() );
 			}
@@ -196,24 +949,251 @@ class ValuePlug::Computation
 	
 		const ValuePlug *m_resultPlug;
 		IECore::ConstObjectPtr m_resultValue;
+		CachePolicy m_cachePolicy;
+		size_t m_computeTimeThreshold;
+		ValueCache *m_cache;
 
 		typedef std::stack<Computation *> ComputationStack;
 		typedef tbb::enumerable_thread_specific<ComputationStack> ThreadSpecificComputationStack;
 		static ThreadSpecificComputationStack g_threadComputations;
 		
-		static IECore::ObjectPtr nullGetter( const IECore::MurmurHash &h, size_t &cost )
+		static ValueCache g_valueCache;
+		static ValueCache g_poolCache;
+		static size_t g_cacheComputeTimeThreshold;
+		
+		// Used to allow threads to wait for a computation being
+		// performed by another thread.
+		class InFlightComputation
 		{
-			cost = 0;
-			return NULL;
-		}
 		
-		typedef IECore::LRUCache<IECore::MurmurHash, IECore::ConstObjectPtr> ValueCache;
-		static ValueCache g_valueCache;
+			public :
+			
+				InFlightComputation()
+					:	m_finished( false )
+				{
+				}
+				
+				// Returns the result, or NULL if the computation failed.
+				IECore::ConstObjectPtr wait()
+				{
+					boost::unique_lock<boost::mutex> lock( m_mutex );
+					while( !m_finished )
+					{
+						m_condition.wait( lock );
+					}
+					return m_result;
+				}
+				
+				void finish( IECore::ConstObjectPtr result )
+				{
+					{
+						boost::lock_guard<boost::mutex> lock( m_mutex );
+						m_result = result;
+						m_finished = true;
+					}
+					m_condition.notify_all();
+				}
+				
+			private :
+			
+				boost::mutex m_mutex;
+				boost::condition_variable m_condition;
+				bool m_finished;
+				IECore::ConstObjectPtr m_result;
+				
+		};
+		
+		typedef boost::shared_ptr<InFlightComputation> InFlightComputationPtr;
+		typedef tbb::concurrent_hash_map<IECore::MurmurHash, InFlightComputationPtr> InFlightComputations;
+		static InFlightComputations g_inFlightComputations;
+		
+		// The number of in-flight computations owned by each thread.
+		static tbb::enumerable_thread_specific<size_t> g_threadOwnedComputations;
+		
+		typedef tbb::concurrent_queue<tbb::task_arena *> ArenaPool;
+		static ArenaPool g_arenaPool;
+		static tbb::atomic<size_t> g_arenaPoolSize;
 		
 };
 
 ValuePlug::Computation::ThreadSpecificComputationStack ValuePlug::Computation::g_threadComputations;
-ValuePlug::Computation::ValueCache ValuePlug::Computation::g_valueCache( nullGetter, 1024 * 1024 * 500 );
+ValueCache ValuePlug::Computation::g_valueCache( 1024 * 1024 * 500 );
+ValueCache ValuePlug::Computation::g_poolCache( 1024 * 1024 * 100 );
+size_t ValuePlug::Computation::g_cacheComputeTimeThreshold = 100;
+ValuePlug::Computation::InFlightComputations ValuePlug::Computation::g_inFlightComputations;
+tbb::enumerable_thread_specific<size_t> ValuePlug::Computation::g_threadOwnedComputations( 0 );
+ValuePlug::Computation::ArenaPool ValuePlug::Computation::g_arenaPool;
+tbb::atomic<size_t> ValuePlug::Computation::g_arenaPoolSize;
+
+//////////////////////////////////////////////////////////////////////////
+// HashCache implementation
+// Computing a hash requires a traversal of the entire upstream graph,
+// so we cache the hashes for computed plugs, keyed on the plug and the
+// current context. Rather than explicitly remove entries when plugs are
+// dirtied, we include the plug's dirty count in the key, so that stale
+// entries can never be returned and are simply evicted as the cache
+// fills up. As with the ValueCache, the cache is split into independent
+// shards so that threads don't serialise on a single lock. Because every
+// entry has the same cost, we can simply divide the memory limit evenly
+// between the shards.
+//////////////////////////////////////////////////////////////////////////
+
+class ValuePlug::HashCache
+{
+
+	public :
+
+		static IECore::MurmurHash hash( const ValuePlug *plug, const ComputeNode *node )
+		{
+			const Context *context = Context::current();
+			if( !g_memoryLimit )
+			{
+				// caching disabled - avoid the overhead of
+				// computing the key.
+				return hashInternal( plug, node, context );
+			}
+
+			IECore::MurmurHash key;
+			key.append( (uint64_t)plug );
+			key.append( (uint64_t)plug->m_dirtyCount );
+			key.append( context->hash() );
+
+			Cache &cache = shard( key );
+			IECore::MurmurHash result = cache.get( key );
+			if( result != g_emptyHash )
+			{
+				++g_hits;
+				return result;
+			}
+
+			++g_misses;
+			result = hashInternal( plug, node, context );
+			cache.set( key, result, g_entryCost );
+			return result;
+		}
+
+		static size_t getMemoryLimit()
+		{
+			return g_memoryLimit;
+		}
+
+		static void setMemoryLimit( size_t bytes )
+		{
+			g_memoryLimit = bytes;
+			for( Shards::const_iterator it = g_shards.begin(), eIt = g_shards.end(); it != eIt; ++it )
+			{
+				(*it)->setMaxCost( bytes / numShards );
+			}
+		}
+
+		static size_t memoryUsage()
+		{
+			size_t result = 0;
+			for( Shards::const_iterator it = g_shards.begin(), eIt = g_shards.end(); it != eIt; ++it )
+			{
+				result += (*it)->currentCost();
+			}
+			return result;
+		}
+
+		static size_t hits()
+		{
+			return g_hits;
+		}
+
+		static size_t misses()
+		{
+			return g_misses;
+		}
+
+		static void clear()
+		{
+			for( Shards::const_iterator it = g_shards.begin(), eIt = g_shards.end(); it != eIt; ++it )
+			{
+				(*it)->clear();
+			}
+			g_hits = 0;
+			g_misses = 0;
+		}
+
+		static uint64_t newDirtyCount()
+		{
+			return ++g_dirtyCount;
+		}
+
+	private :
+
+		static IECore::MurmurHash hashInternal( const ValuePlug *plug, const ComputeNode *node, const Context *context )
+		{
+			PerformanceMonitor::recordHash( plug );
+			IECore::MurmurHash result;
+			node->hash( plug, context, result );
+			if( result == g_emptyHash )
+			{
+				throw IECore::Exception( boost::str( boost::format( "ComputeNode::hash() not implemented for Plug \"%s\"." ) % plug->fullName() ) );
+			}
+			return result;
+		}
+
+		static IECore::MurmurHash nullGetter( const IECore::MurmurHash &h, size_t &cost )
+		{
+			cost = 0;
+			return g_emptyHash;
+		}
+
+		typedef IECore::LRUCache<IECore::MurmurHash, IECore::MurmurHash> Cache;
+		typedef boost::shared_ptr<Cache> CachePtr;
+		typedef std::vector<CachePtr> Shards;
+
+		static Shards createShards( size_t memoryLimit )
+		{
+			// g_memoryLimit has been zero initialised by the time
+			// we are called during static initialisation.
+			g_memoryLimit = memoryLimit;
+			Shards result;
+			for( size_t i = 0; i < numShards; ++i )
+			{
+				result.push_back( CachePtr( new Cache( nullGetter, memoryLimit / numShards ) ) );
+			}
+			return result;
+		}
+
+		static Cache &shard( const IECore::MurmurHash &key )
+		{
+			// as for the ValueCache, use the high bits so that the
+			// choice of shard is independent of any hashing done
+			// within the shard itself.
+			const size_t h = tbb::tbb_hash_compare<IECore::MurmurHash>::hash( key );
+			return *g_shards[ ( h >> ( sizeof( size_t ) * 8 - 8 ) ) % numShards ];
+		}
+
+		static const size_t numShards = 16;
+		static tbb::atomic<size_t> g_memoryLimit;
+		static Shards g_shards;
+
+		// Approximate cost of each entry, including the bookkeeping
+		// overhead within the LRUCache itself.
+		static const size_t g_entryCost = 128;
+		static const IECore::MurmurHash g_emptyHash;
+
+		static tbb::atomic<size_t> g_hits;
+		static tbb::atomic<size_t> g_misses;
+		// Dirty counts are allocated from a single global counter, so
+		// that they are unique across all plugs. This means that a new
+		// plug allocated at the address of a deleted one can never pick
+		// up the cache entries of its predecessor.
+		static tbb::atomic<uint64_t> g_dirtyCount;
+
+};
+
+const size_t ValuePlug::HashCache::numShards;
+tbb::atomic<size_t> ValuePlug::HashCache::g_memoryLimit;
+ValuePlug::HashCache::Shards ValuePlug::HashCache::g_shards = ValuePlug::HashCache::createShards( 1024 * 1024 * 50 );
+const size_t ValuePlug::HashCache::g_entryCost;
+const IECore::MurmurHash ValuePlug::HashCache::g_emptyHash;
+tbb::atomic<size_t> ValuePlug::HashCache::g_hits;
+tbb::atomic<size_t> ValuePlug::HashCache::g_misses;
+tbb::atomic<uint64_t> ValuePlug::HashCache::g_dirtyCount;
 
 //////////////////////////////////////////////////////////////////////////
 // SetValueAction implementation
@@ -289,11 +1269,13 @@ ValuePlug::ValuePlug( const std::string &name, Direction direction,
 	:	Plug( name, direction, flags ), m_staticValue( initialValue )
 {
 	assert( m_staticValue );
+	m_dirtyCount = HashCache::newDirtyCount();
 }
 
 ValuePlug::ValuePlug( const std::string &name, Direction direction, unsigned flags )
 	:	Plug( name, direction, flags ), m_staticValue( 0 )
 {
+	m_dirtyCount = HashCache::newDirtyCount();
 }
 
 ValuePlug::~ValuePlug()
@@ -393,12 +1375,7 @@ IECore::MurmurHash ValuePlug::hash() const
 			const ComputeNode *n = ancestor<ComputeNode>();
 			if( n )
 			{
-				IECore::MurmurHash emptyHash;
-				n->hash( this, Context::current(), h );
-				if( h == emptyHash )
-				{
-					throw IECore::Exception( boost::str( boost::format( "ComputeNode::hash() not implemented for Plug \"%s\"." ) % fullName() ) );			
-				}
+				h = HashCache::hash( this, n );
 			}
 			else
 			{
@@ -492,6 +1469,11 @@ void ValuePlug::setValueInternal( IECore::ConstObjectPtr value, bool propagateDi
 	}
 }
 
+void ValuePlug::dirty()
+{
+	m_dirtyCount = HashCache::newDirtyCount();
+}
+
 void ValuePlug::emitPlugSet()
 {
 	if( Node *n = node() )
@@ -530,3 +1512,88 @@ size_t ValuePlug::cacheMemoryUsage()
 {
 	return Computation::cacheMemoryUsage();
 }
+
+size_t ValuePlug::cacheMemoryUsage( CachePolicy policy )
+{
+	return Computation::cacheMemoryUsage( policy );
+}
+
+size_t ValuePlug::getCachePoolMemoryLimit()
+{
+	return Computation::getCachePoolMemoryLimit();
+}
+
+void ValuePlug::setCachePoolMemoryLimit( size_t bytes )
+{
+	Computation::setCachePoolMemoryLimit( bytes );
+}
+
+size_t ValuePlug::getCacheComputeTimeThreshold()
+{
+	return Computation::getCacheComputeTimeThreshold();
+}
+
+void ValuePlug::setCacheComputeTimeThreshold( size_t microseconds )
+{
+	Computation::setCacheComputeTimeThreshold( microseconds );
+}
+
+ValuePlug::CacheEvictionPolicy ValuePlug::getCacheEvictionPolicy()
+{
+	return Computation::getCacheEvictionPolicy();
+}
+
+void ValuePlug::setCacheEvictionPolicy( CacheEvictionPolicy policy )
+{
+	Computation::setCacheEvictionPolicy( policy );
+}
+
+size_t ValuePlug::numCacheShards()
+{
+	return Computation::numCacheShards();
+}
+
+ValuePlug::CacheStatistics ValuePlug::cacheStatistics( size_t shard )
+{
+	return Computation::cacheStatistics( shard );
+}
+
+ValuePlug::CacheStatistics ValuePlug::cachePoolStatistics( size_t shard )
+{
+	return Computation::cachePoolStatistics( shard );
+}
+
+void ValuePlug::resetCacheStatistics()
+{
+	Computation::resetCacheStatistics();
+}
+
+size_t ValuePlug::getHashCacheMemoryLimit()
+{
+	return HashCache::getMemoryLimit();
+}
+
+void ValuePlug::setHashCacheMemoryLimit( size_t bytes )
+{
+	HashCache::setMemoryLimit( bytes );
+}
+
+size_t ValuePlug::hashCacheMemoryUsage()
+{
+	return HashCache::memoryUsage();
+}
+
+size_t ValuePlug::hashCacheHits()
+{
+	return HashCache::hits();
+}
+
+size_t ValuePlug::hashCacheMisses()
+{
+	return HashCache::misses();
+}
+
+void ValuePlug::clearHashCache()
+{
+	HashCache::clear();
+}
@@ -38,6 +38,7 @@
 #include "boost/python.hpp"
 
 #include "IECorePython/RunTimeTypedBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
 
 #include "Gaffer/BoxPlug.h"
 
@@ -48,6 +49,16 @@ using namespace boost::python;
 using namespace GafferBindings;
 using namespace Gaffer;
 
+template<typename T>
+static typename T::ValueType getValue( const T *plug )
+{
+	// Must release the GIL in case the computation spawns threads which need
+	// to reenter Python, or another thread is already computing the value and
+	// needs the GIL to finish.
+	IECorePython::ScopedGILRelease r;
+	return plug->getValue();
+}
+
 template<typename T>
 static void bind()
 {
@@ -65,7 +76,7 @@ static void bind()
 		)
 		.def( "defaultValue", &T::defaultValue )
 		.def( "setValue", &T::setValue )
-		.def( "getValue", &T::getValue )
+		.def( "getValue", &getValue<T> )
 	;
 }
 
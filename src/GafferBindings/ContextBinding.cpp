@@ -176,6 +176,7 @@ void GafferBindings::bindContext()
 		.def( "names", &names )
 		.def( "keys", &names )
 		.def( "changedSignal", &Context::changedSignal, return_internal_reference<1>() )
+		.def( "hash", &Context::hash )
 		.def( self == self )
 		.def( self != self )
 		.def( "substitute", &Context::substitute )
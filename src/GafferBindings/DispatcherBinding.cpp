@@ -36,9 +36,14 @@
 
 #include "boost/python.hpp"
 
+#include "IECorePython/RefCountedBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
+
 #include "Gaffer/Context.h"
 #include "Gaffer/Dispatcher.h"
 #include "Gaffer/CompoundPlug.h"
+#include "Gaffer/InProcessDispatcher.h"
+#include "Gaffer/ExecutionLedger.h"
 
 #include "GafferBindings/DispatcherBinding.h"
 #include "GafferBindings/NodeBinding.h"
@@ -66,19 +71,6 @@ class DispatcherWrapper : public NodeWrapper<Dispatcher>
 		{
 		}
 
-		void dispatch( list nodeList ) const
-		{
-			ScopedGILLock gilLock;
-			size_t len = boost::python::len( nodeList );
-			std::vector<ExecutableNodePtr> nodes;
-			nodes.reserve( len );
-			for ( size_t i = 0; i < len; i++ )
-			{
-				nodes.push_back( extract<ExecutableNodePtr>( nodeList[i] ) );
-			}
-			Dispatcher::dispatch( nodes );
-		}
-
 		void doDispatch( const TaskDescriptions &taskDescriptions ) const
 		{
 			ScopedGILLock gilLock;
@@ -142,6 +134,22 @@ class DispatcherWrapper : public NodeWrapper<Dispatcher>
 
 };
 
+void dispatch( Dispatcher &dispatcher, list nodeList )
+{
+	size_t len = boost::python::len( nodeList );
+	std::vector<ExecutableNodePtr> nodes;
+	nodes.reserve( len );
+	for ( size_t i = 0; i < len; i++ )
+	{
+		nodes.push_back( extract<ExecutableNodePtr>( nodeList[i] ) );
+	}
+	
+	// Release the GIL so that dispatchers which execute tasks on
+	// other threads may call back into python.
+	ScopedGILRelease gilRelease;
+	dispatcher.dispatch( nodes );
+}
+
 struct DispatchSlotCaller
 {
 	boost::signals::detail::unusable operator()( boost::python::object slot, const Dispatcher *d, const std::vector<ExecutableNodePtr> &nodes )
@@ -168,21 +176,32 @@ struct DispatchSlotCaller
 
 void GafferBindings::bindDispatcher()
 {
-	scope s = NodeClass<Dispatcher, DispatcherWrapper>()
-		.def( "dispatch", &DispatcherWrapper::dispatch )
-		.def( "jobDirectory", &Dispatcher::jobDirectory )
-		.def( "dispatcher", &DispatcherWrapper::dispatcher ).staticmethod( "dispatcher" )
-		.def( "dispatcherNames", &DispatcherWrapper::dispatcherNames ).staticmethod( "dispatcherNames" )
-		.def( "registerDispatcher", &DispatcherWrapper::registerDispatcher ).staticmethod( "registerDispatcher" )
-		.def( "preDispatchSignal", &Dispatcher::preDispatchSignal, return_value_policy<reference_existing_object>() ).staticmethod( "preDispatchSignal" )
-		.def( "postDispatchSignal", &Dispatcher::postDispatchSignal, return_value_policy<reference_existing_object>() ).staticmethod( "postDispatchSignal" )
-	;
+	{
+		scope s = NodeClass<Dispatcher, DispatcherWrapper>()
+			.def( "dispatch", &dispatch )
+			.def( "jobDirectory", &Dispatcher::jobDirectory )
+			.def( "dispatcher", &DispatcherWrapper::dispatcher ).staticmethod( "dispatcher" )
+			.def( "dispatcherNames", &DispatcherWrapper::dispatcherNames ).staticmethod( "dispatcherNames" )
+			.def( "registerDispatcher", &DispatcherWrapper::registerDispatcher ).staticmethod( "registerDispatcher" )
+			.def( "preDispatchSignal", &Dispatcher::preDispatchSignal, return_value_policy<reference_existing_object>() ).staticmethod( "preDispatchSignal" )
+			.def( "postDispatchSignal", &Dispatcher::postDispatchSignal, return_value_policy<reference_existing_object>() ).staticmethod( "postDispatchSignal" )
+		;
 	
-	enum_<Dispatcher::FramesMode>( "FramesMode" )
-		.value( "CurrentFrame", Dispatcher::CurrentFrame )
-		.value( "ScriptRange", Dispatcher::ScriptRange )
-		.value( "CustomRange", Dispatcher::CustomRange )
-	;
+		enum_<Dispatcher::FramesMode>( "FramesMode" )
+			.value( "CurrentFrame", Dispatcher::CurrentFrame )
+			.value( "ScriptRange", Dispatcher::ScriptRange )
+			.value( "CustomRange", Dispatcher::CustomRange )
+		;
 	
-	SignalBinder<Dispatcher::DispatchSignal, DefaultSignalCaller<Dispatcher::DispatchSignal>, DispatchSlotCaller >::bind( "DispatchSignal" );
+		SignalBinder<Dispatcher::DispatchSignal, DefaultSignalCaller<Dispatcher::DispatchSignal>, DispatchSlotCaller >::bind( "DispatchSignal" );
+	}
+
+	NodeClass<InProcessDispatcher>();
+	
+	RefCountedClass<ExecutionLedger, RefCounted>( "ExecutionLedger" )
+		.def( init<const std::string &>() )
+		.def( "fileName", &ExecutionLedger::fileName, return_value_policy<copy_const_reference>() )
+		.def( "executed", &ExecutionLedger::executed )
+		.def( "record", &ExecutionLedger::record )
+	;
 }
@@ -198,6 +198,7 @@ void GafferBindings::bindExpression()
 	
 	IECorePython::RefCountedClass<Expression::Engine, IECore::RefCounted, EngineWrapper>( "Engine" )
 		.def( init<>() )
+		.def( "create", &Expression::Engine::create ).staticmethod( "create" )
 		.def( "registerEngine", &registerEngine ).staticmethod( "registerEngine" )
 		.def( "registeredEngines", &registeredEnginesWrapper ).staticmethod( "registeredEngines" )
 	;
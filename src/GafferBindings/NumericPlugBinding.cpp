@@ -102,6 +102,16 @@ static void setValue( T *plug, const typename T::ValueType value )
 	plug->setValue( value );
 }
 
+template<typename T>
+static typename T::ValueType getValue( const T *plug )
+{
+	// Must release the GIL in case the computation spawns threads which need
+	// to reenter Python, or another thread is already computing the value and
+	// needs the GIL to finish.
+	IECorePython::ScopedGILRelease r;
+	return plug->getValue();
+}
+
 template<typename T>
 class NumericPlugSerialiser : public ValuePlugSerialiser
 {
@@ -138,7 +148,7 @@ static void bind()
 		.def( "minValue", &T::minValue )
 		.def( "maxValue", &T::maxValue )
 		.def( "setValue", setValue<T> )
-		.def( "getValue", &T::getValue )
+		.def( "getValue", &getValue<T> )
 		.def( "__repr__", &repr<T> )
 	;
 	
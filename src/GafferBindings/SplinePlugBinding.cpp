@@ -38,6 +38,7 @@
 #include "boost/python.hpp"
 
 #include "IECorePython/RunTimeTypedBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
 
 #include "Gaffer/Node.h"
 #include "Gaffer/SplinePlug.h"
@@ -72,6 +73,16 @@ class SplinePlugSerialiser : public CompoundPlugSerialiser
 		
 };
 
+template<typename T>
+static typename T::ValueType getValue( const T *plug )
+{
+	// Must release the GIL in case the computation spawns threads which need
+	// to reenter Python, or another thread is already computing the value and
+	// needs the GIL to finish.
+	IECorePython::ScopedGILRelease r;
+	return plug->getValue();
+}
+
 template<typename T>
 static CompoundPlugPtr pointPlug( T &s, size_t index )
 {
@@ -107,7 +118,7 @@ static void bind()
 		)
 		.def( "defaultValue", &T::defaultValue, return_value_policy<copy_const_reference>() )
 		.def( "setValue", &T::setValue )
-		.def( "getValue", &T::getValue )
+		.def( "getValue", &getValue<T> )
 		.def( "numPoints", &T::numPoints )
 		.def( "addPoint", &T::addPoint )
 		.def( "removePoint", &T::removePoint )
@@ -40,6 +40,7 @@
 #include "IECore/MessageHandler.h"
 #include "IECore/NullObject.h"
 #include "IECorePython/RunTimeTypedBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
 
 #include "Gaffer/TypedObjectPlug.h"
 #include "Gaffer/Node.h"
@@ -80,7 +81,14 @@ static void setValue( typename T::Ptr p, typename T::ValuePtr v, bool copy=true
 template<typename T>
 static IECore::ObjectPtr getValue( typename T::Ptr p, bool copy=true )
 {
-	typename IECore::ConstObjectPtr v = p->getValue();
+	typename IECore::ConstObjectPtr v;
+	{
+		// Must release the GIL in case the computation spawns threads which need
+		// to reenter Python, or another thread is already computing the value and
+		// needs the GIL to finish.
+		IECorePython::ScopedGILRelease r;
+		v = p->getValue();
+	}
 	if( v )
 	{
 		if( copy )
@@ -61,6 +61,16 @@ static void setValue( T *plug, const typename T::ValueType value )
 }
 
 
+template<typename T>
+static typename T::ValueType getValue( const T *plug )
+{
+	// Must release the GIL in case the computation spawns threads which need
+	// to reenter Python, or another thread is already computing the value and
+	// needs the GIL to finish.
+	IECorePython::ScopedGILRelease r;
+	return plug->getValue();
+}
+
 template<typename T>
 static void bind()
 {
@@ -78,7 +88,7 @@ static void bind()
 		)
 		.def( "defaultValue", &T::defaultValue, return_value_policy<copy_const_reference>() )
 		.def( "setValue", &setValue<T> )
-		.def( "getValue", &T::getValue )
+		.def( "getValue", &getValue<T> )
 	;
 	
 }
@@ -197,7 +197,7 @@ bool ValuePlugSerialiser::valueNeedsSerialisation( const Gaffer::ValuePlug *plug
 
 void GafferBindings::bindValuePlug()
 {
-	PlugClass<ValuePlug>()
+	scope s = PlugClass<ValuePlug>()
 		.def( "settable", &ValuePlug::settable )
 		.def( "setFrom", &ValuePlug::setFrom )
 		.def( "setToDefault", &ValuePlug::setToDefault )
@@ -207,10 +207,62 @@ void GafferBindings::bindValuePlug()
 		.staticmethod( "getCacheMemoryLimit" )
 		.def( "setCacheMemoryLimit", &ValuePlug::setCacheMemoryLimit )
 		.staticmethod( "setCacheMemoryLimit" )
-		.def( "cacheMemoryUsage", &ValuePlug::cacheMemoryUsage )
+		.def( "cacheMemoryUsage", (size_t (*)())&ValuePlug::cacheMemoryUsage )
+		.def( "cacheMemoryUsage", (size_t (*)( ValuePlug::CachePolicy ))&ValuePlug::cacheMemoryUsage )
 		.staticmethod( "cacheMemoryUsage" )
+		.def( "getCachePoolMemoryLimit", &ValuePlug::getCachePoolMemoryLimit )
+		.staticmethod( "getCachePoolMemoryLimit" )
+		.def( "setCachePoolMemoryLimit", &ValuePlug::setCachePoolMemoryLimit )
+		.staticmethod( "setCachePoolMemoryLimit" )
+		.def( "getCacheComputeTimeThreshold", &ValuePlug::getCacheComputeTimeThreshold )
+		.staticmethod( "getCacheComputeTimeThreshold" )
+		.def( "setCacheComputeTimeThreshold", &ValuePlug::setCacheComputeTimeThreshold )
+		.staticmethod( "setCacheComputeTimeThreshold" )
+		.def( "getCacheEvictionPolicy", &ValuePlug::getCacheEvictionPolicy )
+		.staticmethod( "getCacheEvictionPolicy" )
+		.def( "setCacheEvictionPolicy", &ValuePlug::setCacheEvictionPolicy )
+		.staticmethod( "setCacheEvictionPolicy" )
+		.def( "numCacheShards", &ValuePlug::numCacheShards )
+		.staticmethod( "numCacheShards" )
+		.def( "cacheStatistics", &ValuePlug::cacheStatistics )
+		.staticmethod( "cacheStatistics" )
+		.def( "cachePoolStatistics", &ValuePlug::cachePoolStatistics )
+		.staticmethod( "cachePoolStatistics" )
+		.def( "resetCacheStatistics", &ValuePlug::resetCacheStatistics )
+		.staticmethod( "resetCacheStatistics" )
+		.def( "getHashCacheMemoryLimit", &ValuePlug::getHashCacheMemoryLimit )
+		.staticmethod( "getHashCacheMemoryLimit" )
+		.def( "setHashCacheMemoryLimit", &ValuePlug::setHashCacheMemoryLimit )
+		.staticmethod( "setHashCacheMemoryLimit" )
+		.def( "hashCacheMemoryUsage", &ValuePlug::hashCacheMemoryUsage )
+		.staticmethod( "hashCacheMemoryUsage" )
+		.def( "hashCacheHits", &ValuePlug::hashCacheHits )
+		.staticmethod( "hashCacheHits" )
+		.def( "hashCacheMisses", &ValuePlug::hashCacheMisses )
+		.staticmethod( "hashCacheMisses" )
+		.def( "clearHashCache", &ValuePlug::clearHashCache )
+		.staticmethod( "clearHashCache" )
 		.def( "__repr__", &repr )
 	;
+	
+	enum_<ValuePlug::CachePolicy>( "CachePolicy" )
+		.value( "Uncached", ValuePlug::Uncached )
+		.value( "Cached", ValuePlug::Cached )
+		.value( "CachedIfExpensive", ValuePlug::CachedIfExpensive )
+		.value( "CachedInPool", ValuePlug::CachedInPool )
+	;
+	
+	enum_<ValuePlug::CacheEvictionPolicy>( "CacheEvictionPolicy" )
+		.value( "LeastRecentlyUsed", ValuePlug::LeastRecentlyUsed )
+		.value( "CostAware", ValuePlug::CostAware )
+	;
+	
+	class_<ValuePlug::CacheStatistics>( "CacheStatistics", no_init )
+		.def_readonly( "hits", &ValuePlug::CacheStatistics::hits )
+		.def_readonly( "misses", &ValuePlug::CacheStatistics::misses )
+		.def_readonly( "evictions", &ValuePlug::CacheStatistics::evictions )
+		.def_readonly( "memoryUsage", &ValuePlug::CacheStatistics::memoryUsage )
+	;
 
 	Serialisation::registerSerialiser( Gaffer::ValuePlug::staticTypeId(), new ValuePlugSerialiser );
 }
@@ -61,11 +61,6 @@ ColorProcessor::ColorProcessor( const std::string &name )
 			new ObjectVector
 		)
 	);
-
-	// Because our implementation of computeChannelData() is so simple,
-	// just copying data out of our intermediate colorDataPlug(), it is
-	// actually quicker not to cache the result.
-	outPlug()->channelDataPlug()->setFlags( Plug::Cacheable, false );
 }
 
 ColorProcessor::~ColorProcessor()
@@ -103,6 +98,15 @@ void ColorProcessor::affects( const Gaffer::Plug *input, AffectedPlugsContainer
 	}
 }
 
+Gaffer::ValuePlug::CachePolicy ColorProcessor::cachePolicy( const Gaffer::ValuePlug *output ) const
+{
+	if( output == outPlug()->channelDataPlug() )
+	{
+		return ValuePlug::Uncached;
+	}
+	return ImageProcessor::cachePolicy( output );
+}
+
 bool ColorProcessor::channelEnabled( const std::string &channel ) const
 {
 	if( !ImageProcessor::channelEnabled( channel ) )
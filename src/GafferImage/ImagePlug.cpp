@@ -87,7 +87,7 @@ class CopyTiles
 
 		void operator()( const blocked_range2d<size_t>& r ) const
 		{
-			ContextPtr context = new Context( *m_parentContext );
+			Context::EditableScope scope( m_parentContext );
 			const Box2i operationWindow( V2i( r.rows().begin()+m_dataWindow.min.x, r.cols().begin()+m_dataWindow.min.y ), V2i( r.rows().end()+m_dataWindow.min.x-1, r.cols().end()+m_dataWindow.min.y-1 ) );
 			V2i minTileOrigin = ImagePlug::tileOrigin( operationWindow.min );
 			V2i maxTileOrigin = ImagePlug::tileOrigin( operationWindow.max );
@@ -99,9 +99,8 @@ class CopyTiles
 				{
 					for( vector<string>::const_iterator it = m_channelNames.begin(), eIt = m_channelNames.end(); it != eIt; it++ )
 					{
-						context->set( ImagePlug::channelNameContextName, *it );
-						context->set( ImagePlug::tileOriginContextName, V2i( tileOriginX, tileOriginY ) );
-						Context::Scope scope( context );
+						scope.set( ImagePlug::channelNameContextName, *it );
+						scope.set( ImagePlug::tileOriginContextName, V2i( tileOriginX, tileOriginY ) );
 						Box2i tileBound( V2i( tileOriginX, tileOriginY ), V2i( tileOriginX + m_tileSize - 1, tileOriginY + m_tileSize - 1 ) );
 						Box2i b = boxIntersection( tileBound, operationWindow );
 
@@ -283,20 +282,18 @@ IECore::ConstFloatVectorDataPtr ImagePlug::channelData( const std::string &chann
 		return channelDataPlug()->defaultValue();
 	}
 	
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	tmpContext->set( ImagePlug::channelNameContextName, channelName );
-	tmpContext->set( ImagePlug::tileOriginContextName, tile );
-	Context::Scope scopedContext( tmpContext );
+	Context::EditableScope scope( Context::current() );
+	scope.set( ImagePlug::channelNameContextName, channelName );
+	scope.set( ImagePlug::tileOriginContextName, tile );
 	
 	return channelDataPlug()->getValue();
 }
 
 IECore::MurmurHash ImagePlug::channelDataHash( const std::string &channelName, const Imath::V2i &tile ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	tmpContext->set( ImagePlug::channelNameContextName, channelName );
-	tmpContext->set( ImagePlug::tileOriginContextName, tile );
-	Context::Scope scopedContext( tmpContext );
+	Context::EditableScope scope( Context::current() );
+	scope.set( ImagePlug::channelNameContextName, channelName );
+	scope.set( ImagePlug::tileOriginContextName, tile );
 	return channelDataPlug()->hash();
 }
 
@@ -349,7 +346,7 @@ IECore::MurmurHash ImagePlug::imageHash() const
 	V2i minTileOrigin = tileOrigin( dataWindow.min );
 	V2i maxTileOrigin = tileOrigin( dataWindow.max );
 
-	ContextPtr context = new Context( *Context::current(), Context::Borrowed );
+	Context::EditableScope scope( Context::current() );
 	for( vector<string>::const_iterator it = channelNames.begin(), eIt = channelNames.end(); it!=eIt; it++ )
 	{
 		for( int tileOriginY = minTileOrigin.y; tileOriginY<=maxTileOrigin.y; tileOriginY += tileSize() )
@@ -358,9 +355,8 @@ IECore::MurmurHash ImagePlug::imageHash() const
 			{
 				for( vector<string>::const_iterator it = channelNames.begin(), eIt = channelNames.end(); it!=eIt; it++ )
 				{
-					context->set( ImagePlug::channelNameContextName, *it );
-					context->set( ImagePlug::tileOriginContextName, V2i( tileOriginX, tileOriginY ) );
-					Context::Scope scope( context );
+					scope.set( ImagePlug::channelNameContextName, *it );
+					scope.set( ImagePlug::tileOriginContextName, V2i( tileOriginX, tileOriginY ) );
 					channelDataPlug()->hash( result );
 				}
 			}
@@ -96,12 +96,6 @@ ImageReader::ImageReader( const std::string &name )
 {
 	storeIndexOfNextChild( g_firstPlugIndex );
 	addChild( new StringPlug( "fileName" ) );
-	
-	// disable caching on our outputs, as OIIO is already doing caching for us.
-	for( OutputPlugIterator it( outPlug() ); it!=it.end(); it++ )
-	{
-		(*it)->setFlags( Plug::Cacheable, false );
-	}
 }
 
 ImageReader::~ImageReader()
@@ -149,6 +143,15 @@ size_t ImageReader::supportedExtensions( std::vector<std::string> &extensions )
 	return extensions.size();
 }
 
+Gaffer::ValuePlug::CachePolicy ImageReader::cachePolicy( const Gaffer::ValuePlug *output ) const
+{
+	if( output->parent<ImagePlug>() == outPlug() )
+	{
+		return ValuePlug::Uncached;
+	}
+	return ImageNode::cachePolicy( output );
+}
+
 void ImageReader::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	ImageNode::affects( input, outputs );
@@ -34,21 +34,167 @@
 //  
 //////////////////////////////////////////////////////////////////////////
 
+#include "tbb/parallel_reduce.h"
+#include "tbb/blocked_range.h"
+
 #include "boost/bind.hpp"
 
+#include "IECore/BoxAlgo.h"
+#include "IECore/CompoundData.h"
+#include "IECore/VectorTypedData.h"
+
 #include "Gaffer/TypedPlug.h"
 #include "Gaffer/BoxPlug.h"
 #include "Gaffer/Context.h"
 #include "Gaffer/ScriptNode.h"
 
 #include "GafferImage/ImageStats.h"
-#include "GafferImage/Sampler.h"
 #include "GafferImage/ChannelMaskPlug.h"
 #include "GafferImage/Format.h"
 
+using namespace tbb;
+using namespace Imath;
+using namespace IECore;
 using namespace GafferImage;
 using namespace Gaffer;
 
+//////////////////////////////////////////////////////////////////////////
+// Statistics accumulation
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Accumulates statistics for the tiles of a channel, suitable for use
+// with tbb::parallel_reduce().
+class StatisticsAccumulator
+{
+
+	public :
+
+		StatisticsAccumulator( const ImagePlug *image, const std::string &channelName, const std::vector<V2i> &tileOrigins, const Box2i &region, const V2f &histogramRange, int histogramBins, const Context *context )
+			:	m_image( image ), m_channelName( channelName ), m_tileOrigins( tileOrigins ), m_region( region ),
+				m_histogramMin( histogramRange[0] ), m_histogramScale( 0 ), m_context( context ),
+				min( std::numeric_limits<float>::max() ), max( -std::numeric_limits<float>::max() ), sum( 0 ), histogram( histogramBins, 0 )
+		{
+			if( histogramRange[1] > histogramRange[0] )
+			{
+				m_histogramScale = histogramBins / ( histogramRange[1] - histogramRange[0] );
+			}
+		}
+
+		StatisticsAccumulator( StatisticsAccumulator &other, split )
+			:	m_image( other.m_image ), m_channelName( other.m_channelName ), m_tileOrigins( other.m_tileOrigins ), m_region( other.m_region ),
+				m_histogramMin( other.m_histogramMin ), m_histogramScale( other.m_histogramScale ), m_context( other.m_context ),
+				min( std::numeric_limits<float>::max() ), max( -std::numeric_limits<float>::max() ), sum( 0 ), histogram( other.histogram.size(), 0 )
+		{
+		}
+
+		void operator()( const blocked_range<size_t> &r )
+		{
+			Context::Scope scope( m_context );
+			const int tileSize = ImagePlug::tileSize();
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				const V2i &tileOrigin = m_tileOrigins[i];
+				ConstFloatVectorDataPtr tileData = m_image->channelData( m_channelName, tileOrigin );
+				const std::vector<float> &tile = tileData->readable();
+
+				const Box2i bound = boxIntersection( m_region, Box2i( tileOrigin, tileOrigin + V2i( tileSize - 1 ) ) );
+				for( int y = bound.min.y; y <= bound.max.y; ++y )
+				{
+					const float *v = &tile[( y - tileOrigin.y ) * tileSize + bound.min.x - tileOrigin.x];
+					const float *e = v + bound.size().x + 1;
+					double rowSum = 0;
+					for( ; v != e; ++v )
+					{
+						min = std::min( *v, min );
+						max = std::max( *v, max );
+						rowSum += *v;
+						accumulateHistogram( *v, 1 );
+					}
+					sum += rowSum;
+				}
+			}
+		}
+
+		void join( const StatisticsAccumulator &other )
+		{
+			min = std::min( min, other.min );
+			max = std::max( max, other.max );
+			sum += other.sum;
+			for( size_t i = 0, e = histogram.size(); i < e; ++i )
+			{
+				histogram[i] += other.histogram[i];
+			}
+		}
+
+		void accumulateHistogram( float v, int count )
+		{
+			const float f = ( v - m_histogramMin ) * m_histogramScale;
+			// written to also put NaNs in the first bin
+			int bin = 0;
+			if( f > 0.0f )
+			{
+				bin = f < (float)histogram.size() ? (int)f : (int)histogram.size() - 1;
+			}
+			histogram[bin] += count;
+		}
+
+	private :
+
+		const ImagePlug *m_image;
+		const std::string &m_channelName;
+		const std::vector<V2i> &m_tileOrigins;
+		const Box2i m_region;
+		const float m_histogramMin;
+		float m_histogramScale;
+		const Context *m_context;
+
+	public :
+
+		float min;
+		float max;
+		double sum;
+		std::vector<int> histogram;
+
+};
+
+// Estimates the value at the specified percentile by interpolating
+// within the appropriate histogram bin.
+float percentileValue( const std::vector<int> &histogram, const V2f &histogramRange, float min, float max, float percentile )
+{
+	size_t total = 0;
+	for( std::vector<int>::const_iterator it = histogram.begin(), eIt = histogram.end(); it != eIt; ++it )
+	{
+		total += *it;
+	}
+
+	const double target = total * std::max( 0.0f, std::min( 100.0f, percentile ) ) / 100.0;
+	const float binWidth = ( histogramRange[1] - histogramRange[0] ) / histogram.size();
+
+	float result = histogramRange[1];
+	size_t accumulated = 0;
+	for( size_t i = 0, e = histogram.size(); i < e; ++i )
+	{
+		if( histogram[i] && accumulated + histogram[i] >= target )
+		{
+			const float t = ( target - accumulated ) / histogram[i];
+			result = histogramRange[0] + binWidth * ( i + t );
+			break;
+		}
+		accumulated += histogram[i];
+	}
+
+	return std::max( min, std::min( max, result ) );
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// ImageStats
+//////////////////////////////////////////////////////////////////////////
+
 IE_CORE_DEFINERUNTIMETYPED( ImageStats );
 
 size_t ImageStats::g_firstPlugIndex = 0;
@@ -70,6 +216,12 @@ ImageStats::ImageStats( const std::string &name )
 	addChild( new Color4fPlug( "average", Gaffer::Plug::Out ) );
 	addChild( new Color4fPlug( "min", Gaffer::Plug::Out ) );
 	addChild( new Color4fPlug( "max", Gaffer::Plug::Out ) );
+	addChild( new V2fPlug( "histogramRange", Gaffer::Plug::In, V2f( 0, 1 ) ) );
+	addChild( new IntPlug( "histogramBins", Gaffer::Plug::In, 256, 1 ) );
+	addChild( new ObjectPlug( "histogram", Gaffer::Plug::Out, new CompoundData() ) );
+	addChild( new FloatPlug( "percentile", Gaffer::Plug::In, 50, 0, 100 ) );
+	addChild( new Color4fPlug( "percentileValue", Gaffer::Plug::Out ) );
+	addChild( new ObjectPlug( "__statistics", Gaffer::Plug::Out, new CompoundData() ) );
 	plugInputChangedSignal().connect( boost::bind( &ImageStats::inputChanged, this, ::_1 ) );
 }
 
@@ -137,6 +289,66 @@ const Color4fPlug *ImageStats::maxPlug() const
 	return getChild<Color4fPlug>( g_firstPlugIndex + 5 );
 }
 
+V2fPlug *ImageStats::histogramRangePlug()
+{
+	return getChild<V2fPlug>( g_firstPlugIndex + 6 );
+}
+
+const V2fPlug *ImageStats::histogramRangePlug() const
+{
+	return getChild<V2fPlug>( g_firstPlugIndex + 6 );
+}
+
+IntPlug *ImageStats::histogramBinsPlug()
+{
+	return getChild<IntPlug>( g_firstPlugIndex + 7 );
+}
+
+const IntPlug *ImageStats::histogramBinsPlug() const
+{
+	return getChild<IntPlug>( g_firstPlugIndex + 7 );
+}
+
+ObjectPlug *ImageStats::histogramPlug()
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 8 );
+}
+
+const ObjectPlug *ImageStats::histogramPlug() const
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 8 );
+}
+
+FloatPlug *ImageStats::percentilePlug()
+{
+	return getChild<FloatPlug>( g_firstPlugIndex + 9 );
+}
+
+const FloatPlug *ImageStats::percentilePlug() const
+{
+	return getChild<FloatPlug>( g_firstPlugIndex + 9 );
+}
+
+Color4fPlug *ImageStats::percentileValuePlug()
+{
+	return getChild<Color4fPlug>( g_firstPlugIndex + 10 );
+}
+
+const Color4fPlug *ImageStats::percentileValuePlug() const
+{
+	return getChild<Color4fPlug>( g_firstPlugIndex + 10 );
+}
+
+ObjectPlug *ImageStats::statisticsPlug()
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 11 );
+}
+
+const ObjectPlug *ImageStats::statisticsPlug() const
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 11 );
+}
+
 void ImageStats::inputChanged( Gaffer::Plug *plug )
 {
 	const Imath::Box2i regionOfInterest( regionOfInterestPlug()->getValue() );
@@ -173,8 +385,20 @@ void ImageStats::parentChanging( Gaffer::GraphComponent *newParent )
 void ImageStats::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	ComputeNode::affects( input, outputs );
+	
+	if(
+		input->parent<ImagePlug>() == inPlug() ||
+		regionOfInterestPlug()->isAncestorOf( input ) ||
+		histogramRangePlug()->isAncestorOf( input ) ||
+		input == histogramBinsPlug()
+	)
+	{
+		outputs.push_back( statisticsPlug() );
+	}
+	
 	if (
 			input == channelsPlug() ||
+			input == statisticsPlug() ||
 			input->parent<ImagePlug>() == inPlug() ||
 			regionOfInterestPlug()->isAncestorOf( input )
 	   ) 
@@ -184,22 +408,58 @@ void ImageStats::affects( const Gaffer::Plug *input, AffectedPlugsContainer &out
 			outputs.push_back( minPlug()->getChild(i) );	
 			outputs.push_back( averagePlug()->getChild(i) );	
 			outputs.push_back( maxPlug()->getChild(i) );	
+			outputs.push_back( percentileValuePlug()->getChild(i) );	
 		}
+		outputs.push_back( histogramPlug() );
 		return;
 	}
+	
+	if( input == percentilePlug() )
+	{
+		for( unsigned int i = 0; i < 4; ++i )
+		{
+			outputs.push_back( percentileValuePlug()->getChild(i) );	
+		}
+	}
 }
 
 void ImageStats::hash( const ValuePlug *output, const Context *context, IECore::MurmurHash &h ) const
 {
 	ComputeNode::hash( output, context, h);
 	
+	if( output == statisticsPlug() )
+	{
+		hashStatistics( context, h );
+		return;
+	}
+	
+	if( output == histogramPlug() )
+	{
+		regionOfInterestPlug()->hash( h );
+		
+		IECore::ConstStringVectorDataPtr channelNamesData = inPlug()->channelNamesPlug()->getValue();
+		std::vector<std::string> maskChannels = channelNamesData->readable();
+		channelsPlug()->maskChannels( maskChannels );
+		
+		ContextPtr tmpContext = new Context( *context, Context::Borrowed );
+		Context::Scope scopedContext( tmpContext );
+		for( std::vector<std::string>::const_iterator it = maskChannels.begin(), eIt = maskChannels.end(); it != eIt; ++it )
+		{
+			h.append( *it );
+			tmpContext->set( ImagePlug::channelNameContextName, *it );
+			statisticsPlug()->hash( h );
+		}
+		return;
+	}
+	
 	bool earlyOut = true;
 	for( int i = 0; i < 4; ++i )
 	{
 		if (
 				output == minPlug()->getChild(i) ||
 				output == maxPlug()->getChild(i) ||
-				output == averagePlug()->getChild(i)
+				output == averagePlug()->getChild(i) ||
+				output == percentileValuePlug()->getChild(i)
 		   )
 		{
 			earlyOut = false;
@@ -211,37 +471,31 @@ void ImageStats::hash( const ValuePlug *output, const Context *context, IECore::
 		return;
 	}
 
-	const Imath::Box2i regionOfInterest( regionOfInterestPlug()->getValue() );
 	regionOfInterestPlug()->hash( h );
-	inPlug()->channelNamesPlug()->hash( h );
-	inPlug()->dataWindowPlug()->hash( h );
 
-	IECore::ConstStringVectorDataPtr channelNamesData = inPlug()->channelNamesPlug()->getValue();
-	std::vector<std::string> maskChannels = channelNamesData->readable();
-	channelsPlug()->maskChannels( maskChannels );
-	const int nChannels( maskChannels.size() );
-	
-	if ( nChannels > 0 )
+	std::string channel;
+	channelNameFromOutput( output, channel );
+	if ( !channel.empty() )
 	{
-		std::vector<std::string> uniqueChannels = maskChannels;
-		GafferImage::ChannelMaskPlug::removeDuplicateIndices( uniqueChannels );
-		std::string channel;
-		channelNameFromOutput( output, channel );
-
-		if ( !channel.empty() )
+		h.append( channel );
+		if( output->parent<Plug>() == percentileValuePlug() )
 		{
-			h.append( channel );	
-			Sampler s( inPlug(), channel, regionOfInterest );
-			s.hash( h );
-			return;
+			percentilePlug()->hash( h );
 		}
+		
+		ContextPtr tmpContext = new Context( *context, Context::Borrowed );
+		tmpContext->set( ImagePlug::channelNameContextName, channel );
+		Context::Scope scopedContext( tmpContext );
+		statisticsPlug()->hash( h );
+		return;
 	}
 
 	// If our node is not enabled then we just append the default value that we will give the plug.
 	if(
 			output == maxPlug()->getChild(3) ||
 			output == minPlug()->getChild(3) ||
-			output == averagePlug()->getChild(3)
+			output == averagePlug()->getChild(3) ||
+			output == percentileValuePlug()->getChild(3)
 	  )
 	{
 		h.append( 0 );
@@ -252,6 +506,95 @@ void ImageStats::hash( const ValuePlug *output, const Context *context, IECore::
 	}
 }
 
+void ImageStats::hashStatistics( const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	const std::string &channelName = context->get<std::string>( ImagePlug::channelNameContextName );
+	h.append( channelName );
+	
+	regionOfInterestPlug()->hash( h );
+	inPlug()->dataWindowPlug()->hash( h );
+	histogramRangePlug()->hash( h );
+	histogramBinsPlug()->hash( h );
+	
+	const Box2i region = boxIntersection( regionOfInterestPlug()->getValue(), inPlug()->dataWindowPlug()->getValue() );
+	if( region.isEmpty() )
+	{
+		return;
+	}
+	
+	const V2i minTileOrigin = ImagePlug::tileOrigin( region.min );
+	const V2i maxTileOrigin = ImagePlug::tileOrigin( region.max );
+	for( int tileOriginY = minTileOrigin.y; tileOriginY <= maxTileOrigin.y; tileOriginY += ImagePlug::tileSize() )
+	{
+		for( int tileOriginX = minTileOrigin.x; tileOriginX <= maxTileOrigin.x; tileOriginX += ImagePlug::tileSize() )
+		{
+			h.append( inPlug()->channelDataHash( channelName, V2i( tileOriginX, tileOriginY ) ) );
+		}
+	}
+}
+
+IECore::ConstObjectPtr ImageStats::computeStatistics( const Gaffer::Context *context ) const
+{
+	const std::string &channelName = context->get<std::string>( ImagePlug::channelNameContextName );
+	const Box2i regionOfInterest = regionOfInterestPlug()->getValue();
+	const V2f histogramRange = histogramRangePlug()->getValue();
+	const int histogramBins = histogramBinsPlug()->getValue();
+	
+	// Gather the tiles intersecting the region of interest, and accumulate
+	// the statistics for them in parallel. Pixels outside the data window
+	// are black, and are accounted for separately afterwards.
+	
+	Box2i region;
+	std::vector<V2i> tileOrigins;
+	if( !regionOfInterest.isEmpty() )
+	{
+		region = boxIntersection( regionOfInterest, inPlug()->dataWindowPlug()->getValue() );
+		if( !region.isEmpty() )
+		{
+			const V2i minTileOrigin = ImagePlug::tileOrigin( region.min );
+			const V2i maxTileOrigin = ImagePlug::tileOrigin( region.max );
+			for( int tileOriginY = minTileOrigin.y; tileOriginY <= maxTileOrigin.y; tileOriginY += ImagePlug::tileSize() )
+			{
+				for( int tileOriginX = minTileOrigin.x; tileOriginX <= maxTileOrigin.x; tileOriginX += ImagePlug::tileSize() )
+				{
+					tileOrigins.push_back( V2i( tileOriginX, tileOriginY ) );
+				}
+			}
+		}
+	}
+	
+	StatisticsAccumulator accumulator( inPlug(), channelName, tileOrigins, region, histogramRange, histogramBins, context );
+	parallel_reduce( blocked_range<size_t>( 0, tileOrigins.size() ), accumulator );
+	
+	size_t numPixels = 0;
+	if( !regionOfInterest.isEmpty() )
+	{
+		numPixels = size_t( regionOfInterest.size().x + 1 ) * size_t( regionOfInterest.size().y + 1 );
+		const size_t numDataPixels = region.isEmpty() ? 0 : size_t( region.size().x + 1 ) * size_t( region.size().y + 1 );
+		if( numDataPixels < numPixels )
+		{
+			accumulator.min = std::min( accumulator.min, 0.0f );
+			accumulator.max = std::max( accumulator.max, 0.0f );
+			accumulator.accumulateHistogram( 0.0f, numPixels - numDataPixels );
+		}
+	}
+	else
+	{
+		accumulator.min = accumulator.max = 0.0f;
+	}
+	
+	CompoundDataPtr result = new CompoundData;
+	result->writable()["min"] = new FloatData( accumulator.min );
+	result->writable()["max"] = new FloatData( accumulator.max );
+	result->writable()["average"] = new FloatData( numPixels ? accumulator.sum / double( numPixels ) : 0.0f );
+	result->writable()["histogramRange"] = new V2fData( histogramRange );
+	IntVectorDataPtr histogram = new IntVectorData;
+	histogram->writable().swap( accumulator.histogram );
+	result->writable()["histogram"] = histogram;
+	
+	return result;
+}
+
 void ImageStats::channelNameFromOutput( const ValuePlug *output, std::string &channelName ) const
 {
 	IECore::ConstStringVectorDataPtr channelNamesData = inPlug()->channelNamesPlug()->getValue();
@@ -268,7 +611,8 @@ void ImageStats::channelNameFromOutput( const ValuePlug *output, std::string &ch
 	{
 		if ( output == minPlug()->getChild( channelIndex ) ||
 			 output == maxPlug()->getChild( channelIndex ) ||
-			 output == averagePlug()->getChild( channelIndex )
+			 output == averagePlug()->getChild( channelIndex ) ||
+			 output == percentileValuePlug()->getChild( channelIndex )
 		   )
 		{
 			for( std::vector<std::string>::iterator it( uniqueChannels.begin() ); it != uniqueChannels.end(); ++it )
@@ -289,7 +633,8 @@ void ImageStats::setOutputToDefault( FloatPlug *output ) const
 	if (
 			output == minPlug()->getChild(3) ||
 			output == maxPlug()->getChild(3) ||
-			output == averagePlug()->getChild(3)
+			output == averagePlug()->getChild(3) ||
+			output == percentileValuePlug()->getChild(3)
 	   )
 	{
 		output->setValue( 1. );
@@ -302,7 +647,36 @@ void ImageStats::setOutputToDefault( FloatPlug *output ) const
 
 void ImageStats::compute( ValuePlug *output, const Context *context ) const
 {
+	if( output == statisticsPlug() )
+	{
+		static_cast<ObjectPlug *>( output )->setValue( computeStatistics( context ) );
+		return;
+	}
+	
 	const Imath::Box2i &regionOfInterest( regionOfInterestPlug()->getValue() );
+	
+	if( output == histogramPlug() )
+	{
+		CompoundDataPtr result = new CompoundData;
+		if( !regionOfInterest.isEmpty() )
+		{
+			IECore::ConstStringVectorDataPtr channelNamesData = inPlug()->channelNamesPlug()->getValue();
+			std::vector<std::string> maskChannels = channelNamesData->readable();
+			channelsPlug()->maskChannels( maskChannels );
+			
+			ContextPtr tmpContext = new Context( *context, Context::Borrowed );
+			Context::Scope scopedContext( tmpContext );
+			for( std::vector<std::string>::const_iterator it = maskChannels.begin(), eIt = maskChannels.end(); it != eIt; ++it )
+			{
+				tmpContext->set( ImagePlug::channelNameContextName, *it );
+				ConstCompoundDataPtr statistics = staticPointerCast<const CompoundData>( statisticsPlug()->getValue() );
+				result->writable()[*it] = constPointerCast<IntVectorData>( statistics->member<IntVectorData>( "histogram" ) );
+			}
+		}
+		static_cast<ObjectPlug *>( output )->setValue( result );
+		return;
+	}
+	
 	if( regionOfInterest.isEmpty() )
 	{
 		setOutputToDefault( static_cast<FloatPlug*>( output ) );
@@ -324,25 +698,11 @@ void ImageStats::compute( ValuePlug *output, const Context *context ) const
 	tmpContext->set( ImagePlug::channelNameContextName, channelName );
 	Context::Scope scopedContext( tmpContext );
 
-	// Loop over the ROI and compute the min, max and average channel values and then set our outputs.
-	Sampler s( inPlug(), channelName, regionOfInterest );	
-
-	float min = std::numeric_limits<float>::max();
-	float max = std::numeric_limits<float>::min();
-	float average = 0.f;
-
-	double sum = 0.;
-	for( int y = regionOfInterest.min.y; y <= regionOfInterest.max.y; ++y )
-	{
-		for( int x = regionOfInterest.min.x; x <= regionOfInterest.max.x; ++x )
-		{
-			float v = s.sample( x, y );
-			min = std::min( v, min );
-			max = std::max( v, max );
-			sum += v;
-		}
-	}
-	average = sum / double( (regionOfInterest.size().x+1) * (regionOfInterest.size().y+1) );
+	// All the statistics for the channel are computed together, and cached
+	// on the intermediate plug, so it's cheap to retrieve each one in turn.
+	ConstCompoundDataPtr statistics = staticPointerCast<const CompoundData>( statisticsPlug()->getValue() );
+	const float min = statistics->member<FloatData>( "min" )->readable();
+	const float max = statistics->member<FloatData>( "max" )->readable();
 
 	if ( minPlug()->getChild( channelIndex ) == output )
 	{
@@ -354,11 +714,21 @@ void ImageStats::compute( ValuePlug *output, const Context *context ) const
 	}
 	else if ( averagePlug()->getChild( channelIndex ) == output )
 	{
-		static_cast<FloatPlug *>( output )->setValue( average );
+		static_cast<FloatPlug *>( output )->setValue( statistics->member<FloatData>( "average" )->readable() );
+	}
+	else if ( percentileValuePlug()->getChild( channelIndex ) == output )
+	{
+		static_cast<FloatPlug *>( output )->setValue(
+			percentileValue(
+				statistics->member<IntVectorData>( "histogram" )->readable(),
+				statistics->member<V2fData>( "histogramRange" )->readable(),
+				min, max,
+				percentilePlug()->getValue()
+			)
+		);
 	}
 	else
 	{
 		static_cast<FloatPlug *>( output )->setValue( 0 );
 	}
 }
-
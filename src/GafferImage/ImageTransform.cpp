@@ -35,6 +35,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "IECore/AngleConversion.h"
+#include "IECore/FastFloat.h"
 
 #include "Gaffer/Context.h"
 
@@ -51,6 +52,173 @@ using namespace GafferImage;
 
 IE_CORE_DEFINERUNTIMETYPED( ImageTransform );
 
+//////////////////////////////////////////////////////////////////////////
+// Separable resampling utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// The filter taps and weights for every pixel along one axis of an
+// output tile. When the transform has no rotation or shear, the sample
+// position along each axis depends only on the row or column of the output
+// pixel, so these can be computed once per tile row and column instead of
+// once per pixel.
+struct AxisWeights
+{
+
+	AxisWeights( const Filter *filter, const std::vector<float> &centers )
+	{
+		const bool box = static_cast<GafferImage::TypeId>( filter->typeId() ) == GafferImage::BoxFilterTypeId;
+		width = box ? 1 : filter->width();
+
+		taps.resize( centers.size() );
+		weights.resize( centers.size() * width );
+		totals.resize( centers.size() );
+		min = std::numeric_limits<int>::max();
+		max = std::numeric_limits<int>::min();
+
+		for( size_t i = 0; i < centers.size(); ++i )
+		{
+			const float center = centers[i];
+			float *w = &weights[i*width];
+			if( box )
+			{
+				// Match Sampler::sample( float, float ), which just
+				// point samples when using a box filter.
+				taps[i] = IECore::fastFloatFloor( center );
+				w[0] = totals[i] = 1.0f;
+			}
+			else
+			{
+				// Filter::tap() requires a positive center, so we
+				// offset it into the positive range and back again.
+				const int offset = IECore::fastFloatFloor( center ) - width;
+				taps[i] = filter->tap( center - offset ) + offset;
+				totals[i] = 0.0f;
+				for( int k = 0; k < width; ++k )
+				{
+					w[k] = filter->weight( center, taps[i] + k );
+					totals[i] += w[k];
+				}
+			}
+			min = std::min( min, taps[i] );
+			max = std::max( max, taps[i] + width - 1 );
+		}
+	}
+
+	int width;
+	// The first input pixel contributing to each output pixel.
+	std::vector<int> taps;
+	// The weights for each of the contributing input pixels.
+	std::vector<float> weights;
+	// The sum of the weights for each output pixel.
+	std::vector<float> totals;
+	// The range of input pixels used by all the output pixels.
+	int min;
+	int max;
+
+};
+
+// Fills a tile by sampling the input at the positions given by the matrix m,
+// which must not contain any rotation or shear. This is equivalent to calling
+// sampler.sample( float, float ) for each pixel, but filters in two separable
+// passes, reading the input a whole row at a time.
+void resampleSeparable( Sampler &sampler, const Filter *filter, const Imath::M33f &m, const Imath::Box2i &tile, std::vector<float> &out )
+{
+	const int tileSize = ImagePlug::tileSize();
+
+	std::vector<float> xCenters( tileSize );
+	std::vector<float> yCenters( tileSize );
+	for( int i = 0; i < tileSize; ++i )
+	{
+		Imath::V3f p( i+tile.min.x+.5, i+tile.min.y+.5, 1. );
+		p *= m;
+		xCenters[i] = p.x;
+		yCenters[i] = p.y;
+	}
+
+	const AxisWeights xWeights( filter, xCenters );
+	const AxisWeights yWeights( filter, yCenters );
+
+	// Find the input rows we need. When downsizing, the filter support
+	// of neighbouring output rows may not overlap, and we don't want to
+	// filter the rows in the gaps between them. We map each needed row
+	// to its position in the buffer for the horizontal pass.
+	const int yRange = yWeights.max - yWeights.min + 1;
+	std::vector<int> bufferRows( yRange, -1 );
+	for( int j = 0; j < tileSize; ++j )
+	{
+		const int firstRow = yWeights.taps[j] - yWeights.min;
+		for( int k = 0; k < yWeights.width; ++k )
+		{
+			bufferRows[firstRow+k] = 0;
+		}
+	}
+	int numBufferRows = 0;
+	for( int y = 0; y < yRange; ++y )
+	{
+		if( bufferRows[y] != -1 )
+		{
+			bufferRows[y] = numBufferRows++;
+		}
+	}
+
+	// Horizontal pass. Filter every input row that we need into a buffer
+	// with one value per output column.
+	const int rowWidth = xWeights.max - xWeights.min + 1;
+	std::vector<float> row( rowWidth );
+	std::vector<float> buffer( numBufferRows * tileSize );
+	for( int y = yWeights.min; y <= yWeights.max; ++y )
+	{
+		const int bufferRow = bufferRows[y - yWeights.min];
+		if( bufferRow == -1 )
+		{
+			continue;
+		}
+		sampler.sampleRow( xWeights.min, y, rowWidth, &row[0] );
+		float *b = &buffer[ bufferRow * tileSize ];
+		for( int i = 0; i < tileSize; ++i )
+		{
+			const float *r = &row[ xWeights.taps[i] - xWeights.min ];
+			const float *w = &xWeights.weights[ i * xWeights.width ];
+			float v = 0.0f;
+			for( int k = 0; k < xWeights.width; ++k )
+			{
+				v += r[k] * w[k];
+			}
+			b[i] = v;
+		}
+	}
+
+	// Vertical pass. Accumulate the filtered rows into each output
+	// row, and normalise by the total weight.
+	for( int j = 0; j < tileSize; ++j )
+	{
+		float *o = &out[ j * tileSize ];
+		std::fill( o, o + tileSize, 0.0f );
+
+		const int *rows = &bufferRows[ yWeights.taps[j] - yWeights.min ];
+		const float *w = &yWeights.weights[ j * yWeights.width ];
+		for( int k = 0; k < yWeights.width; ++k )
+		{
+			const float *b = &buffer[ rows[k] * tileSize ];
+			for( int i = 0; i < tileSize; ++i )
+			{
+				o[i] += b[i] * w[k];
+			}
+		}
+
+		for( int i = 0; i < tileSize; ++i )
+		{
+			const float total = xWeights.totals[i] * yWeights.totals[j];
+			o[i] = total == 0 ? 0 : o[i] / total;
+		}
+	}
+}
+
+} // namespace
+
 //////////////////////////////////////////////////////////////////////////
 // Implementation of ImageTransform::Implementation
 //////////////////////////////////////////////////////////////////////////
@@ -348,6 +516,30 @@ IECore::ConstFloatVectorDataPtr Implementation::computeChannelData( const std::s
 	
 	GafferImage::FilterPtr filter = GafferImage::Filter::create( filterPlug()->getValue() );
 	Sampler sampler( inPlug(), channelName, sampleBox, filter );
+
+	// When translating or upsizing, almost all of the sample box will be
+	// accessed, so it's quicker to fetch the input tiles in parallel up
+	// front. When downsizing, or when the box bounds a rotated tile, much
+	// of it may never be accessed, and prefetching would compute tiles for
+	// nothing. Prefetching also spawns nested parallel work, so we only do
+	// it for small boxes or when we know it will pay off.
+	const bool separable = t[0][1] == 0.0f && t[1][0] == 0.0f;
+	const bool upsizing = separable && fabs( t[0][0] ) <= 1.1f && fabs( t[1][1] ) <= 1.1f;
+	const Imath::V2i sampleBoxSize = sampleBox.size() + Imath::V2i( 1 );
+	const bool smallBox = sampleBoxSize.x * sampleBoxSize.y <= 4 * ImagePlug::tileSize() * ImagePlug::tileSize();
+	if( upsizing || smallBox )
+	{
+		sampler.prefetch();
+	}
+
+	// Translation and scaling can be computed much more efficiently as
+	// two separable passes. We only need the general case for rotation.
+	if( separable )
+	{
+		resampleSeparable( sampler, filter.get(), t, tile, out );
+		return outDataPtr;
+	}
+
 	for ( int j = 0; j < ImagePlug::tileSize(); ++j )
 	{
 		for ( int i = 0; i < ImagePlug::tileSize(); ++i )
@@ -169,6 +169,17 @@ IECore::MurmurHash ImageWriter::executionHash( const Context *context ) const
 	return h;
 }
 
+void ImageWriter::executionOutputs( const Gaffer::Context *context, std::vector<std::string> &fileNames ) const
+{
+	Context::Scope scope( context );
+	fileNames.push_back( context->substitute( fileNamePlug()->getValue() ) );
+}
+
+bool ImageWriter::executionHashIsComplete() const
+{
+	return true;
+}
+
 ///\todo: We are currently computing all of the channels regardless of whether or not we are outputting them.
 /// Change the execute() method to only compute the channels that are masked by the channelsPlug().
 
@@ -40,20 +40,6 @@
 using namespace IECore;
 using namespace Gaffer;
 
-// Create a set of functions to perform the different operations.
-typedef float (*Op)( float A, float B, float a, float b );
-float opAdd( float A, float B, float a, float b){ return A + B; }
-float opAtop( float A, float B, float a, float b){ return A*b + B*(1.-a); }
-float opDivide( float A, float B, float a, float b){ return A / B; }
-float opIn( float A, float B, float a, float b){ return A*b; }
-float opOut( float A, float B, float a, float b){ return A*(1.-b); }
-float opMask( float A, float B, float a, float b){ return B*a; }
-float opMatte( float A, float B, float a, float b){ return A*a + B*(1.-a); }
-float opMultiply( float A, float B, float a, float b){ return A * B; }
-float opOver( float A, float B, float a, float b){ return A + B*(1.-a); }
-float opSubtract( float A, float B, float a, float b){ return A - B; }
-float opUnder( float A, float B, float a, float b){ return A*(1.-b) + B; }
-
 namespace GafferImage
 {
 
@@ -123,26 +109,26 @@ IECore::ConstFloatVectorDataPtr Merge::computeChannelData( const std::string &ch
 		}
 	}
 
-	// Get a pointer to the operation that we wish to perform.
+	// Dispatch to the kernel for the operation that we wish to perform.
 	int operation = operationPlug()->getValue();
 	switch( operation )
 	{
 		default:
-		case( kAdd ): return doMergeOperation( opAdd, inData, inAlpha, tileOrigin ); break;
-		case( kAtop ): return doMergeOperation( opAtop, inData, inAlpha, tileOrigin ); break;
-		case( kDivide ): return doMergeOperation( opDivide, inData, inAlpha, tileOrigin ); break;
-		case( kIn ): return doMergeOperation( opIn, inData, inAlpha, tileOrigin ); break;
-		case( kOut ): return doMergeOperation( opOut, inData, inAlpha, tileOrigin ); break;
-		case( kMask ): return doMergeOperation( opMask, inData, inAlpha, tileOrigin ); break;
-		case( kMatte ): return doMergeOperation( opMatte, inData, inAlpha, tileOrigin ); break;
-		case( kMultiply ): return doMergeOperation( opMultiply, inData, inAlpha, tileOrigin ); break;
-		case( kOver ): return doMergeOperation( opOver, inData, inAlpha, tileOrigin ); break;
-		case( kSubtract ): return doMergeOperation( opSubtract, inData, inAlpha, tileOrigin ); break;
-		case( kUnder ): return doMergeOperation( opUnder, inData, inAlpha, tileOrigin ); break;
+		case( kAdd ): return doMergeOperation<Detail::AddOp>( inData, inAlpha );
+		case( kAtop ): return doMergeOperation<Detail::AtopOp>( inData, inAlpha );
+		case( kDivide ): return doMergeOperation<Detail::DivideOp>( inData, inAlpha );
+		case( kIn ): return doMergeOperation<Detail::InOp>( inData, inAlpha );
+		case( kOut ): return doMergeOperation<Detail::OutOp>( inData, inAlpha );
+		case( kMask ): return doMergeOperation<Detail::MaskOp>( inData, inAlpha );
+		case( kMatte ): return doMergeOperation<Detail::MatteOp>( inData, inAlpha );
+		case( kMultiply ): return doMergeOperation<Detail::MultiplyOp>( inData, inAlpha );
+		case( kOver ): return doMergeOperation<Detail::OverOp>( inData, inAlpha );
+		case( kSubtract ): return doMergeOperation<Detail::SubtractOp>( inData, inAlpha );
+		case( kUnder ): return doMergeOperation<Detail::UnderOp>( inData, inAlpha );
 	}
 
 	// We should never get here...
-	return doMergeOperation( opAdd, inData, inAlpha, tileOrigin );
+	return doMergeOperation<Detail::AddOp>( inData, inAlpha );
 }
 
 bool Merge::hasAlpha( ConstStringVectorDataPtr channelNamesData ) const
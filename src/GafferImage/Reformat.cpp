@@ -35,13 +35,141 @@
 //  
 //////////////////////////////////////////////////////////////////////////
 
+#include <limits>
+
+#include "IECore/LRUCache.h"
+
 #include "GafferImage/Reformat.h"
 #include "GafferImage/Sampler.h"
+#include "GafferImage/VectorTraits.h"
 
 using namespace Gaffer;
 using namespace IECore;
 using namespace GafferImage;
 
+//////////////////////////////////////////////////////////////////////////
+// Contributions cache. The pixels contributing to each pixel of an output
+// tile, along with their weights, depend only on the formats, the filter
+// and the position of the tile. Rather than recompute them for every tile
+// and channel, we cache them per tile row and column, so they can be shared
+// by all the tiles in that row or column.
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// The contributions of input pixels to each of the output pixels
+// along one axis of a tile.
+struct Contributions : public IECore::RefCounted
+{
+
+	// The number of weights per output pixel.
+	int width;
+	// The first input pixel contributing to each output pixel.
+	std::vector<int> taps;
+	// The weights of the input pixels, already normalised by their sum.
+	std::vector<float> weights;
+	// The range of input pixels used by all the output pixels.
+	int min;
+	int max;
+
+};
+
+IE_CORE_DECLAREPTR( Contributions )
+
+typedef LRUCache<MurmurHash, ConstContributionsPtr> ContributionsCache;
+
+ConstContributionsPtr nullGetter( const MurmurHash &h, size_t &cost )
+{
+	cost = 0;
+	return NULL;
+}
+
+ContributionsCache g_contributionsCache( nullGetter, 1024 * 1024 * 16 );
+
+// Returns the contributions for a tile starting at output pixel tileOrigin,
+// for a single axis with the specified scale and format offsets.
+ConstContributionsPtr contributions( const std::string &filterName, float scale, double inFormatOffset, double outFormatOffset, int tileOrigin )
+{
+	MurmurHash key;
+	key.append( filterName );
+	key.append( scale );
+	key.append( inFormatOffset );
+	key.append( outFormatOffset );
+	key.append( tileOrigin );
+
+	ConstContributionsPtr cached = g_contributionsCache.get( key );
+	if( cached )
+	{
+		return cached;
+	}
+
+	ConstFilterPtr filter = Filter::create( filterName, 1.f / scale );
+
+	ContributionsPtr result = new Contributions;
+	result->width = filter->width();
+	result->taps.resize( ImagePlug::tileSize() );
+	result->weights.resize( ImagePlug::tileSize() * result->width );
+	result->min = std::numeric_limits<int>::max();
+	result->max = std::numeric_limits<int>::min();
+
+	for( int i = 0; i < ImagePlug::tileSize(); ++i )
+	{
+		const float center = ( tileOrigin + i + 0.5 - outFormatOffset ) / scale + inFormatOffset;
+		// Filter::tap() requires a positive center, so we offset
+		// it into the positive range and back again.
+		const int offset = IECore::fastFloatFloor( center ) - result->width;
+		const int tap = filter->tap( center - offset ) + offset;
+
+		float *weights = &(result->weights[i * result->width]);
+		float weightedSum = 0.0f;
+		for( int k = 0; k < result->width; ++k )
+		{
+			weights[k] = filter->weight( center, tap + k );
+			weightedSum += weights[k];
+		}
+		if( weightedSum != 0.0f )
+		{
+			for( int k = 0; k < result->width; ++k )
+			{
+				weights[k] /= weightedSum;
+			}
+		}
+
+		result->taps[i] = tap;
+		result->min = std::min( result->min, tap );
+		result->max = std::max( result->max, tap + result->width - 1 );
+	}
+
+	const size_t cost = result->taps.size() * sizeof( int ) + result->weights.size() * sizeof( float );
+	g_contributionsCache.set( key, result, cost );
+
+	return result;
+}
+
+// Adds weight * in[i] to out[i] for all i < size, using SIMD instructions
+// where available.
+void accumulate( float *out, const float *in, float weight, int size )
+{
+	typedef Detail::NativeTraits T;
+	const T::Vector w = T::set( weight );
+	int i = 0;
+	for( ; i + (int)T::width <= size; i += T::width )
+	{
+		T::store( out + i, T::add( T::load( out + i ), T::mul( T::load( in + i ), w ) ) );
+	}
+	for( ; i < size; ++i )
+	{
+		out[i] += in[i] * weight;
+	}
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Reformat implementation
+//////////////////////////////////////////////////////////////////////////
+
 IE_CORE_DEFINERUNTIMETYPED( Reformat );
 
 size_t Reformat::g_firstPlugIndex = 0;
@@ -111,6 +239,15 @@ bool Reformat::enabled() const
 	return inFormat != outFormat;
 }
 
+Gaffer::ValuePlug::CachePolicy Reformat::cachePolicy( const Gaffer::ValuePlug *output ) const
+{
+	if( output == outPlug()->channelDataPlug() )
+	{
+		return ValuePlug::CachedInPool;
+	}
+	return ImageProcessor::cachePolicy( output );
+}
+
 void Reformat::hashFormat( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
 	ImageProcessor::hashFormat( output, context, h );
@@ -198,12 +335,6 @@ Imath::V2d Reformat::scale() const
 	return scale;
 }
 
-struct Contribution
-{
-	int pixel;
-	float weight;
-};
-
 IECore::ConstFloatVectorDataPtr Reformat::computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const
 {
 	// Allocate the new tile
@@ -243,6 +374,7 @@ IECore::ConstFloatVectorDataPtr Reformat::computeChannelData( const std::string
 		);
 
 		Sampler sampler( inPlug(), channelName, sampleBox, f, Sampler::Clamp );
+		sampler.prefetch();
 		for ( int y = outTile.min.y, ty = 0; y <= outTile.max.y; ++y, ++ty )
 		{
 			for ( int x = outTile.min.x, tx = 0; x <= outTile.max.x; ++x, ++tx )
@@ -254,146 +386,76 @@ IECore::ConstFloatVectorDataPtr Reformat::computeChannelData( const std::string
 		return outDataPtr;
 	}
 
-	// Get the dimensions of our filter and create a box that we can use to define the bounds of our input.
-	int fHeight = f->width();
-	
-	int sampleMinY = f->tap( inTile.min.y );
-	int sampleMaxY = f->tap( inTile.max.y );
-		
-	f->setScale( 1.f / scaleFactor.x );
-	int sampleMinX = f->tap( inTile.min.x );
-	int sampleMaxX = f->tap( inTile.max.x );
-	
-	int fWidth = f->width();
+	// Get the contributions of the input pixels to each output column and row.
+	const std::string filterName = filterPlug()->getValue();
+	ConstContributionsPtr xContributions = contributions( filterName, scaleFactor.x, inFormatOffset.x, outFormatOffset.x, outTile.min.x );
+	ConstContributionsPtr yContributions = contributions( filterName, scaleFactor.y, inFormatOffset.y, outFormatOffset.y, outTile.min.y );
 
+	// Read all the input pixels that we need in one go, a row at a time.
 	Imath::Box2i sampleBox(
-		Imath::V2i( sampleMinX, sampleMinY ),
-		Imath::V2i( sampleMaxX + fWidth, sampleMaxY + fHeight )
+		Imath::V2i( xContributions->min, yContributions->min ),
+		Imath::V2i( xContributions->max, yContributions->max )
 	);
+	const int sampleBoxWidth = sampleBox.size().x + 1;
+	const int sampleBoxHeight = sampleBox.size().y + 1;
 
-	int sampleBoxWidth = sampleBox.size().x + 1;
-	int sampleBoxHeight = sampleBox.size().y + 1;
-
-	// Create a temporary buffer that we can write the result of the first pass to.
-	// We extend the buffer vertically as we will need additional information in the
-	// vertical squash (the second pass) to properly convolve the filter.
-	float buffer[ ImagePlug::tileSize() * sampleBoxHeight ];
-	
-	// Create several buffers for each pixel in the output row (or column depending on the pass)
-	// into which we can place the indices for the pixels that are contribute to it's result and
-	// their weight.
-	
-	// A buffer that holds a list of pixel contributions and their weights for every pixel in the output buffer.
-	// As it gets reused for both passes we make it large enough to hold both so that we don't have to resize it later.
-	std::vector<Contribution> contribution( ImagePlug::tileSize() * ( sampleBoxHeight > sampleBoxWidth ? sampleBoxHeight : sampleBoxWidth ) ); 
-	
-	// The total number of pixels that contribute towards each pixel in th resulting image.
-	std::vector<int> coverageTotal( ImagePlug::tileSize() );
-
-	// The total weighted sum of contribution that each pixel in the output gets.
-	// This value is used to normalize the result.
-	std::vector<float> weightedSum( ImagePlug::tileSize() );
-
-	// Horizontal Pass
-	// Here we build a row buffer of contributing pixels and their weights for every pixel in the row.
-	int contributionIdx = 0;
-	for ( int i = 0; i < ImagePlug::tileSize(); ++i, contributionIdx += fWidth )
+	Sampler sampler( inPlug(), channelName, sampleBox, f, Sampler::Clamp );
+	sampler.prefetch();
+	std::vector<float> input( sampleBoxWidth * sampleBoxHeight );
+	sampler.sampleBlock( sampleBox, &input[0] );
+
+	// Vertical pass. Each output row is a weighted sum of whole input
+	// rows, which we accumulate into a buffer.
+	std::vector<float> buffer( ImagePlug::tileSize() * sampleBoxWidth, 0.0f );
+	for( int j = 0; j < ImagePlug::tileSize(); ++j )
 	{
-		float center = ( outTile.min.x + i + 0.5 - outFormatOffset.x ) / scaleFactor.x + inFormatOffset.x;
-		int tap = f->tap( center );
-		
-		int n = 0;	
-		weightedSum[i] = 0.;
-		for ( int j = tap; j < tap+fWidth; ++j )
+		float *b = &buffer[j * sampleBoxWidth];
+		const float *weights = &(yContributions->weights[j * yContributions->width]);
+		const float *in = &input[( yContributions->taps[j] - sampleBox.min.y ) * sampleBoxWidth];
+		for( int k = 0; k < yContributions->width; ++k, in += sampleBoxWidth )
 		{
-			float weight = f->weight( center, j );
-			if ( weight == 0 )
+			if( weights[k] != 0.0f )
 			{
-				continue;
+				accumulate( b, in, weights[k], sampleBoxWidth );
 			}
-			
-			contribution[contributionIdx+n].pixel = j; 
-			weightedSum[i] += contribution[contributionIdx+n].weight = weight; 
-			n++;
 		}
-		coverageTotal[i] = n;
 	}
-	
-	// Now that we know the contribution of each pixel from the others on the row, compute the
-	// horizontally scaled buffer which we will use as input in the vertical scale pass.
-	Sampler sampler( inPlug(), channelName, sampleBox, f, Sampler::Clamp );
-	for ( int k = 0; k < sampleBoxHeight; ++k )
+
+	// Horizontal pass. We transpose the buffer so that this too can be
+	// computed as a weighted sum of whole rows (formerly columns), accumulate
+	// into a transposed output tile, and then transpose that into place.
+	std::vector<float> transposedBuffer( buffer.size() );
+	for( int j = 0; j < ImagePlug::tileSize(); ++j )
 	{
-		for ( int i = 0, contributionIdx = 0; i < ImagePlug::tileSize(); ++i, contributionIdx += fWidth )
+		for( int x = 0; x < sampleBoxWidth; ++x )
 		{
-			float intensity = 0;
-
-			for ( int j = 0; j < coverageTotal[i]; ++j )
-			{
-				Contribution &contributor( contribution[ contributionIdx+j ] );
-
-				if ( contributor.weight == 0. )
-				{
-					continue;
-				}
-
-				float value = sampler.sample( contributor.pixel, k + sampleBox.min.y );
-				intensity += value * contributor.weight;
-			}
-
-			buffer[i + ImagePlug::tileSize() * k] = intensity / weightedSum[i];
+			transposedBuffer[x * ImagePlug::tileSize() + j] = buffer[j * sampleBoxWidth + x];
 		}
 	}
-	
-	// Vertical Pass
-	// Build the column buffer of contributing pixels and their weights for each pixel in the column.
-	f->setScale( 1.f / scaleFactor.y );
-	for ( int i = 0, contributionIdx = 0; i < ImagePlug::tileSize(); ++i, contributionIdx += fHeight )
+
+	std::vector<float> transposedOut( out.size(), 0.0f );
+	for( int i = 0; i < ImagePlug::tileSize(); ++i )
 	{
-		float center = ( outTile.min.y - outFormatOffset.y + i + 0.5 ) / scaleFactor.y - sampleBox.min.y + inFormatOffset.y;
-		int tap = f->tap( center );
-		
-		int n = 0;	
-		weightedSum[i] = 0.;
-		for ( int j = tap; j < tap+fHeight; ++j )
+		float *o = &transposedOut[i * ImagePlug::tileSize()];
+		const float *weights = &(xContributions->weights[i * xContributions->width]);
+		const float *in = &transposedBuffer[( xContributions->taps[i] - sampleBox.min.x ) * ImagePlug::tileSize()];
+		for( int k = 0; k < xContributions->width; ++k, in += ImagePlug::tileSize() )
 		{
-			float weight = f->weight( center, j );
-			if ( weight == 0 )
+			if( weights[k] != 0.0f )
 			{
-				continue;
+				accumulate( o, in, weights[k], ImagePlug::tileSize() );
 			}
-			
-			contribution[contributionIdx+n].pixel = j; 
-			weightedSum[i] += contribution[contributionIdx+n].weight = weight;
-			n++;
 		}
-		coverageTotal[i] = n;
 	}
-	
-	// Use the column buffer of pixel contributions to scale the temporary buffer vertically.
-	// Write the result into the output buffer.
-	for ( int k = 0; k < ImagePlug::tileSize(); ++k )
+
+	for( int i = 0; i < ImagePlug::tileSize(); ++i )
 	{
-		for ( int i = 0, contributionIdx = 0; i < ImagePlug::tileSize(); ++i, contributionIdx += fHeight )
+		for( int j = 0; j < ImagePlug::tileSize(); ++j )
 		{
-			float intensity = 0;
-
-			for ( int j = 0; j < coverageTotal[i]; ++j )
-			{
-				Contribution &contributor( contribution[ contributionIdx+j ] );
-
-				if ( contributor.weight == 0. )
-				{
-					continue;
-				}
-
-				intensity += buffer[ k + ImagePlug::tileSize() * contributor.pixel ] * contributor.weight;
-			}
-
-			out[k + ImagePlug::tileSize() * i] = intensity / weightedSum[i];
+			out[j * ImagePlug::tileSize() + i] = transposedOut[i * ImagePlug::tileSize() + j];
 		}
 	}
-   
+
 	return outDataPtr;
 }
 
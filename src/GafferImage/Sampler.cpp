@@ -34,13 +34,59 @@
 //  
 //////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
 #include "Gaffer/Context.h"
 #include "GafferImage/Sampler.h"
 
+using namespace tbb;
 using namespace Gaffer;
 using namespace IECore;
 using namespace GafferImage;
 
+namespace
+{
+
+// Fills a Sampler's tile cache in parallel.
+class PrefetchTiles
+{
+
+	public :
+
+		PrefetchTiles( const ImagePlug *plug, const std::string &channelName, const Imath::V2i &cacheOrigin, int cacheWidth, std::vector<ConstFloatVectorDataPtr> &dataCache )
+			:	m_plug( plug ), m_channelName( channelName ), m_cacheOrigin( cacheOrigin ), m_cacheWidth( cacheWidth ), m_dataCache( dataCache ), m_context( Context::current() )
+		{
+		}
+
+		void operator()( const blocked_range<size_t> &r ) const
+		{
+			Context::Scope scope( m_context );
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				if( !m_dataCache[i] )
+				{
+					const Imath::V2i cacheIndex( i % m_cacheWidth, i / m_cacheWidth );
+					m_dataCache[i] = m_plug->channelData( m_channelName, m_cacheOrigin + cacheIndex * ImagePlug::tileSize() );
+				}
+			}
+		}
+
+	private :
+
+		const ImagePlug *m_plug;
+		const std::string &m_channelName;
+		const Imath::V2i m_cacheOrigin;
+		const int m_cacheWidth;
+		std::vector<ConstFloatVectorDataPtr> &m_dataCache;
+		const Context *m_context;
+
+};
+
+} // namespace
+
 Sampler::Sampler( const GafferImage::ImagePlug *plug, const std::string &channelName, const Imath::Box2i &window, BoundingMode boundingMode )
 	: m_plug( plug ),
 	m_channelName( channelName ),
@@ -97,3 +143,80 @@ void Sampler::hash( IECore::MurmurHash &h ) const
 	}
 }
 
+
+void Sampler::sampleRow( int x, int y, int width, float *result )
+{
+	float *resultEnd = result + width;
+	if( m_sampleWindow.isEmpty() )
+	{
+		std::fill( result, resultEnd, 0.0f );
+		return;
+	}
+
+	if( y < m_sampleWindow.min.y || y > m_sampleWindow.max.y )
+	{
+		if( m_boundingMode == Black )
+		{
+			std::fill( result, resultEnd, 0.0f );
+			return;
+		}
+		y = std::max( std::min( y, m_sampleWindow.max.y ), m_sampleWindow.min.y );
+	}
+
+	// Pixels before the start of the sample window.
+	const int numBefore = std::max( 0, std::min( width, m_sampleWindow.min.x - x ) );
+	if( numBefore )
+	{
+		std::fill( result, result + numBefore, m_boundingMode == Black ? 0.0f : sample( m_sampleWindow.min.x, y ) );
+		result += numBefore;
+		x += numBefore;
+	}
+
+	// Pixels within the sample window, which we copy in spans
+	// from each tile.
+	const int spanEnd = std::min( x + int( resultEnd - result ), m_sampleWindow.max.x + 1 );
+	const float *tileData;
+	Imath::V2i tileOrigin;
+	Imath::V2i tileIndex;
+	while( x < spanEnd )
+	{
+		cachedData( Imath::V2i( x, y ), tileData, tileOrigin, tileIndex );
+		const int n = std::min( spanEnd, tileOrigin.x + ImagePlug::tileSize() ) - x;
+		const float *tileRow = tileData + tileIndex.y * ImagePlug::tileSize() + tileIndex.x;
+		result = std::copy( tileRow, tileRow + n, result );
+		x += n;
+	}
+
+	// Pixels after the end of the sample window.
+	if( result != resultEnd )
+	{
+		std::fill( result, resultEnd, m_boundingMode == Black ? 0.0f : sample( m_sampleWindow.max.x, y ) );
+	}
+}
+
+void Sampler::sampleBlock( const Imath::Box2i &region, float *result )
+{
+	if( region.isEmpty() )
+	{
+		return;
+	}
+
+	const int width = region.size().x + 1;
+	for( int y = region.min.y; y <= region.max.y; ++y, result += width )
+	{
+		sampleRow( region.min.x, y, width, result );
+	}
+}
+
+void Sampler::prefetch()
+{
+	if( m_sampleWindow.isEmpty() )
+	{
+		return;
+	}
+
+	parallel_for(
+		blocked_range<size_t>( 0, m_dataCache.size() ),
+		PrefetchTiles( m_plug, m_channelName, m_cacheWindow.min, m_cacheWidth, m_dataCache )
+	);
+}
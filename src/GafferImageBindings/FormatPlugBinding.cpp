@@ -39,6 +39,7 @@
 
 #include "IECore/RunTimeTyped.h"
 #include "IECorePython/RunTimeTypedBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
 
 #include "GafferBindings/Serialisation.h"
 #include "GafferBindings/ValuePlugBinding.h"
@@ -105,6 +106,16 @@ class FormatPlugSerialiser : public GafferBindings::ValuePlugSerialiser
 
 } // namespace
 
+template<typename T>
+static typename T::ValueType getValue( const T *plug )
+{
+	// Must release the GIL in case the computation spawns threads which need
+	// to reenter Python, or another thread is already computing the value and
+	// needs the GIL to finish.
+	IECorePython::ScopedGILRelease r;
+	return plug->getValue();
+}
+
 void GafferImageBindings::bindFormatPlug()
 {
 	PlugClass<FormatPlug>()
@@ -119,7 +130,7 @@ void GafferImageBindings::bindFormatPlug()
 		)
 		.def( "defaultValue", &FormatPlug::defaultValue, return_value_policy<copy_const_reference>() )
 		.def( "setValue", &FormatPlug::setValue )
-		.def( "getValue", &FormatPlug::getValue )
+		.def( "getValue", &getValue<FormatPlug> )
 	;
 	
 	Serialisation::registerSerialiser( static_cast<IECore::TypeId>(FormatPlugTypeId), new FormatPlugSerialiser );
@@ -36,6 +36,9 @@
 #include "boost/python.hpp"
 #include "boost/format.hpp"
 
+#include "IECore/VectorTypedData.h"
+#include "IECorePython/ScopedGILRelease.h"
+
 #include "GafferImage/Filter.h"
 #include "GafferBindings/SignalBinding.h"
 #include "GafferBindings/Serialisation.h"
@@ -49,6 +52,34 @@ using namespace GafferImage;
 namespace GafferImageBindings
 {
 
+static FloatVectorDataPtr sampleRow( Sampler &sampler, int x, int y, int width )
+{
+	FloatVectorDataPtr result = new FloatVectorData;
+	result->writable().resize( width );
+	if( width )
+	{
+		sampler.sampleRow( x, y, width, &(result->writable()[0]) );
+	}
+	return result;
+}
+
+static FloatVectorDataPtr sampleBlock( Sampler &sampler, const Imath::Box2i &region )
+{
+	FloatVectorDataPtr result = new FloatVectorData;
+	if( !region.isEmpty() )
+	{
+		result->writable().resize( ( region.size().x + 1 ) * ( region.size().y + 1 ) );
+		sampler.sampleBlock( region, &(result->writable()[0]) );
+	}
+	return result;
+}
+
+static void prefetch( Sampler &sampler )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	sampler.prefetch();
+}
+
 void bindSampler()
 {
 	enum_<Sampler::BoundingMode>( "BoundingMode" )
@@ -77,6 +108,9 @@ void bindSampler()
 		.def( "hash", &Sampler::hash )
 		.def( "sample", (float (Sampler::*)( int, int ) )&Sampler::sample )
 		.def( "sample", (float (Sampler::*)( float, float ) )&Sampler::sample )
+		.def( "sampleRow", &sampleRow )
+		.def( "sampleBlock", &sampleBlock )
+		.def( "prefetch", &prefetch )
 	;
 }
 
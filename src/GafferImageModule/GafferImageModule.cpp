@@ -76,16 +76,32 @@ using namespace GafferImage;
 
 static IECore::FloatVectorDataPtr channelData( const ImagePlug &plug,  const std::string &channelName, const Imath::V2i &tile  )
 {
-	IECore::ConstFloatVectorDataPtr d = plug.channelData( channelName, tile );
+	IECore::ConstFloatVectorDataPtr d;
+	{
+		IECorePython::ScopedGILRelease gilRelease;
+		d = plug.channelData( channelName, tile );
+	}
 	return d ? d->copy() : 0;
 }
 
+static IECore::MurmurHash channelDataHash( const ImagePlug &plug,  const std::string &channelName, const Imath::V2i &tile  )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return plug.channelDataHash( channelName, tile );
+}
+
 static IECore::ImagePrimitivePtr image( const ImagePlug &plug )
 {
 	IECorePython::ScopedGILRelease gilRelease;
 	return plug.image();
 }
 
+static IECore::MurmurHash imageHash( const ImagePlug &plug )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return plug.imageHash();
+}
+
 BOOST_PYTHON_MODULE( _GafferImage )
 {
 	
@@ -101,9 +117,9 @@ BOOST_PYTHON_MODULE( _GafferImage )
 			)	
 		)
 		.def( "channelData", &channelData )
-		.def( "channelDataHash", &ImagePlug::channelDataHash )
+		.def( "channelDataHash", &channelDataHash )
 		.def( "image", &image )
-		.def( "imageHash", &ImagePlug::imageHash )
+		.def( "imageHash", &imageHash )
 		.def( "tileSize", &ImagePlug::tileSize ).staticmethod( "tileSize" )
 		.def( "tileBound", &ImagePlug::tileBound ).staticmethod( "tileBound" )
 		.def( "tileOrigin", &ImagePlug::tileOrigin ).staticmethod( "tileOrigin" )
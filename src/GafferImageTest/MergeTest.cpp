@@ -0,0 +1,104 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2014, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "OpenEXR/ImathRandom.h"
+
+#include "GafferImage/Merge.h"
+
+#include "GafferTest/Assert.h"
+#include "GafferImageTest/MergeTest.h"
+
+using namespace GafferImage;
+
+namespace
+{
+
+// Checks that the native (SIMD) kernel for an operation gives exactly
+// the same results as the scalar one. We use an array size which isn't
+// a multiple of the vector width, so that the scalar remainder handling
+// is exercised too.
+template<typename Op>
+void testMergeKernel()
+{
+	const size_t numInputs = 5;
+	const size_t size = 1027;
+
+	Imath::Rand48 random( 0 );
+
+	std::vector<std::vector<float> > data( numInputs, std::vector<float>( size ) );
+	std::vector<std::vector<float> > alpha( numInputs, std::vector<float>( size ) );
+	std::vector<const float *> dataPointers;
+	std::vector<const float *> alphaPointers;
+	for( size_t i = 0; i < numInputs; ++i )
+	{
+		for( size_t j = 0; j < size; ++j )
+		{
+			data[i][j] = random.nextf( 0.1f, 1.1f );
+			alpha[i][j] = random.nextf( 0.0f, 1.0f );
+		}
+		dataPointers.push_back( &(data[i][0]) );
+		alphaPointers.push_back( &(alpha[i][0]) );
+	}
+
+	std::vector<float> scalarResult( size );
+	std::vector<float> nativeResult( size );
+	Detail::mergeArrays<Op, Detail::ScalarTraits>( &(dataPointers[0]), &(alphaPointers[0]), numInputs, &(scalarResult[0]), size );
+	Detail::mergeArrays<Op, Detail::NativeTraits>( &(dataPointers[0]), &(alphaPointers[0]), numInputs, &(nativeResult[0]), size );
+
+	for( size_t i = 0; i < size; ++i )
+	{
+		GAFFERTEST_ASSERT( scalarResult[i] == nativeResult[i] );
+	}
+}
+
+} // namespace
+
+void GafferImageTest::testMergeKernels()
+{
+	testMergeKernel<Detail::AddOp>();
+	testMergeKernel<Detail::AtopOp>();
+	testMergeKernel<Detail::DivideOp>();
+	testMergeKernel<Detail::InOp>();
+	testMergeKernel<Detail::OutOp>();
+	testMergeKernel<Detail::MaskOp>();
+	testMergeKernel<Detail::MatteOp>();
+	testMergeKernel<Detail::MultiplyOp>();
+	testMergeKernel<Detail::OverOp>();
+	testMergeKernel<Detail::SubtractOp>();
+	testMergeKernel<Detail::UnderOp>();
+}
@@ -84,6 +84,8 @@
 #include "GafferBindings/Serialisation.h"
 #include "GafferBindings/MetadataBinding.h"
 #include "GafferBindings/StringAlgoBinding.h"
+#include "GafferBindings/PerformanceMonitorBinding.h"
+#include "GafferBindings/DirtyPropagationScopeBinding.h"
 
 using namespace boost::python;
 using namespace Gaffer;
@@ -135,6 +137,8 @@ BOOST_PYTHON_MODULE( _Gaffer )
 	bindSerialisation();
 	bindMetadata();
 	bindStringAlgo();
+	bindPerformanceMonitor();
+	bindDirtyPropagationScope();
 			
 	NodeClass<Backdrop>();
 
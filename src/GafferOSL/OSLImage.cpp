@@ -64,11 +64,6 @@ OSLImage::OSLImage( const std::string &name )
 	addChild( new Plug( "shader" ) );
 	
 	addChild( new Gaffer::ObjectPlug( "__shading", Gaffer::Plug::Out, new CompoundData() ) );
-
-	// we disable caching for the channel data plug, because our compute
-	// simply references data direct from the shading plug, which will itself
-	// be cached. we don't want to count the memory usage for that twice.
-	outPlug()->channelDataPlug()->setFlags( Plug::Cacheable, false );
 }
 
 OSLImage::~OSLImage()
@@ -180,6 +175,15 @@ void OSLImage::compute( Gaffer::ValuePlug *output, const Gaffer::Context *contex
 	ImageProcessor::compute( output, context );
 }
 
+Gaffer::ValuePlug::CachePolicy OSLImage::cachePolicy( const Gaffer::ValuePlug *output ) const
+{
+	if( output == outPlug()->channelDataPlug() )
+	{
+		return ValuePlug::Uncached;
+	}
+	return ImageProcessor::cachePolicy( output );
+}
+
 void OSLImage::hashFormat( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
 	h = inPlug()->formatPlug()->hash();
@@ -80,9 +80,8 @@ class MatchingPathsTask : public tbb::task
 		virtual task *execute()
 		{	
 			
-			ContextPtr context = new Context( *m_context, Context::Borrowed );
-			context->set( ScenePlug::scenePathContextName, m_path );
-			Context::Scope scopedContext( context );
+			Context::EditableScope scope( m_context );
+			scope.set( ScenePlug::scenePathContextName, m_path );
 			
 			const Filter::Result match = (Filter::Result)m_filter->getValue();
 			if( match & Filter::ExactMatch )
@@ -205,30 +205,27 @@ const Gaffer::CompoundObjectPlug *ScenePlug::globalsPlug() const
 
 Imath::Box3f ScenePlug::bound( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	tmpContext->set( scenePathContextName, scenePath );
-	Context::Scope scopedContext( tmpContext );	
+	Context::EditableScope scope( Context::current() );
+	scope.set( scenePathContextName, scenePath );
 	return boundPlug()->getValue();
 }
 
 Imath::M44f ScenePlug::transform( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	tmpContext->set( scenePathContextName, scenePath );
-	Context::Scope scopedContext( tmpContext );
+	Context::EditableScope scope( Context::current() );
+	scope.set( scenePathContextName, scenePath );
 	return transformPlug()->getValue();
 }
 
 Imath::M44f ScenePlug::fullTransform( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	Context::Scope scopedContext( tmpContext );
+	Context::EditableScope scope( Context::current() );
 	
 	Imath::M44f result;
 	ScenePath path( scenePath );
 	while( path.size() )
 	{
-		tmpContext->set( scenePathContextName, path );
+		scope.set( scenePathContextName, path );
 		result = result * transformPlug()->getValue();
 		path.pop_back();
 	}
@@ -238,23 +235,21 @@ Imath::M44f ScenePlug::fullTransform( const ScenePath &scenePath ) const
 
 IECore::ConstCompoundObjectPtr ScenePlug::attributes( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	tmpContext->set( scenePathContextName, scenePath );
-	Context::Scope scopedContext( tmpContext );
+	Context::EditableScope scope( Context::current() );
+	scope.set( scenePathContextName, scenePath );
 	return attributesPlug()->getValue();
 }
 
 IECore::CompoundObjectPtr ScenePlug::fullAttributes( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	Context::Scope scopedContext( tmpContext );
+	Context::EditableScope scope( Context::current() );
 
 	IECore::CompoundObjectPtr result = new IECore::CompoundObject;
 	IECore::CompoundObject::ObjectMap &resultMembers = result->members();
 	ScenePath path( scenePath );
 	while( path.size() )
 	{
-		tmpContext->set( scenePathContextName, path );
+		scope.set( scenePathContextName, path );
 		IECore::ConstCompoundObjectPtr a = attributesPlug()->getValue();
 		const IECore::CompoundObject::ObjectMap &aMembers = a->members();
 		for( IECore::CompoundObject::ObjectMap::const_iterator it = aMembers.begin(), eIt = aMembers.end(); it != eIt; it++ )
@@ -272,46 +267,41 @@ IECore::CompoundObjectPtr ScenePlug::fullAttributes( const ScenePath &scenePath
 
 IECore::ConstObjectPtr ScenePlug::object( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	tmpContext->set( scenePathContextName, scenePath );
-	Context::Scope scopedContext( tmpContext );
+	Context::EditableScope scope( Context::current() );
+	scope.set( scenePathContextName, scenePath );
 	return objectPlug()->getValue();
 }
 
 IECore::ConstInternedStringVectorDataPtr ScenePlug::childNames( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	tmpContext->set( scenePathContextName, scenePath );
-	Context::Scope scopedContext( tmpContext );
+	Context::EditableScope scope( Context::current() );
+	scope.set( scenePathContextName, scenePath );
 	return childNamesPlug()->getValue();
 }
 
 IECore::MurmurHash ScenePlug::boundHash( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	tmpContext->set( scenePathContextName, scenePath );
-	Context::Scope scopedContext( tmpContext );
+	Context::EditableScope scope( Context::current() );
+	scope.set( scenePathContextName, scenePath );
 	return boundPlug()->hash();
 }
 
 IECore::MurmurHash ScenePlug::transformHash( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	tmpContext->set( scenePathContextName, scenePath );
-	Context::Scope scopedContext( tmpContext );
+	Context::EditableScope scope( Context::current() );
+	scope.set( scenePathContextName, scenePath );
 	return transformPlug()->hash();
 }
 
 IECore::MurmurHash ScenePlug::fullTransformHash( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	Context::Scope scopedContext( tmpContext );
+	Context::EditableScope scope( Context::current() );
 	
 	IECore::MurmurHash result;
 	ScenePath path( scenePath );
 	while( path.size() )
 	{
-		tmpContext->set( scenePathContextName, path );
+		scope.set( scenePathContextName, path );
 		transformPlug()->hash( result );
 		path.pop_back();
 	}
@@ -321,22 +311,20 @@ IECore::MurmurHash ScenePlug::fullTransformHash( const ScenePath &scenePath ) co
 
 IECore::MurmurHash ScenePlug::attributesHash( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	tmpContext->set( scenePathContextName, scenePath );
-	Context::Scope scopedContext( tmpContext );
+	Context::EditableScope scope( Context::current() );
+	scope.set( scenePathContextName, scenePath );
 	return attributesPlug()->hash();
 }
 
 IECore::MurmurHash ScenePlug::fullAttributesHash( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	Context::Scope scopedContext( tmpContext );
+	Context::EditableScope scope( Context::current() );
 	
 	IECore::MurmurHash result;
 	ScenePath path( scenePath );
 	while( path.size() )
 	{
-		tmpContext->set( scenePathContextName, path );
+		scope.set( scenePathContextName, path );
 		attributesPlug()->hash( result );
 		path.pop_back();
 	}
@@ -346,18 +334,16 @@ IECore::MurmurHash ScenePlug::fullAttributesHash( const ScenePath &scenePath ) c
 
 IECore::MurmurHash ScenePlug::objectHash( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	tmpContext->set( scenePathContextName, scenePath );
-	Context::Scope scopedContext( tmpContext );
+	Context::EditableScope scope( Context::current() );
+	scope.set( scenePathContextName, scenePath );
 	return objectPlug()->hash();
 
 }
 
 IECore::MurmurHash ScenePlug::childNamesHash( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	tmpContext->set( scenePathContextName, scenePath );
-	Context::Scope scopedContext( tmpContext );
+	Context::EditableScope scope( Context::current() );
+	scope.set( scenePathContextName, scenePath );
 	return childNamesPlug()->hash();
 }
 
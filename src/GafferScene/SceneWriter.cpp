@@ -34,6 +34,11 @@
 //  
 //////////////////////////////////////////////////////////////////////////
 
+#include "tbb/task.h"
+#include "tbb/task_group.h"
+
+#include "boost/bind.hpp"
+
 #include "IECore/SceneInterface.h"
 #include "IECore/Transform.h"
 
@@ -46,6 +51,146 @@ using namespace IECore;
 using namespace Gaffer;
 using namespace GafferScene;
 
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// The values for a single location, computed in advance of writing them.
+struct Location
+{
+	ConstCompoundObjectPtr globals;
+	ConstCompoundObjectPtr attributes;
+	ConstObjectPtr object;
+	Imath::Box3f bound;
+	Imath::M44f transform;
+	ConstInternedStringVectorDataPtr childNames;
+	std::vector<Location> children;
+};
+
+// Computes a Location, spawning a child task for each of its children.
+class LocationTask : public tbb::task
+{
+
+	public :
+
+		LocationTask( const ScenePlug *scene, const Context *context, const ScenePlug::ScenePath &scenePath, Location &location )
+			:	m_scene( scene ), m_context( context ), m_scenePath( scenePath ), m_location( location )
+		{
+		}
+
+		virtual ~LocationTask()
+		{
+		}
+
+		virtual task *execute()
+		{
+			Context::EditableScope scope( m_context );
+			scope.set( ScenePlug::scenePathContextName, m_scenePath );
+			
+			if( m_scenePath.empty() )
+			{
+				m_location.globals = m_scene->globalsPlug()->getValue();
+			}
+			else
+			{
+				m_location.transform = m_scene->transformPlug()->getValue();
+			}
+			
+			m_location.attributes = m_scene->attributesPlug()->getValue();
+			m_location.object = m_scene->objectPlug()->getValue();
+			m_location.bound = m_scene->boundPlug()->getValue();
+			m_location.childNames = m_scene->childNamesPlug()->getValue();
+			
+			const vector<InternedString> &childNames = m_location.childNames->readable();
+			m_location.children.resize( childNames.size() );
+			
+			set_ref_count( 1 + childNames.size() );
+			
+			ScenePlug::ScenePath childPath = m_scenePath;
+			childPath.push_back( InternedString() ); // space for the child name
+			for( size_t i = 0, e = childNames.size(); i < e; ++i )
+			{
+				childPath[m_scenePath.size()] = childNames[i];
+				LocationTask *t = new( allocate_child() ) LocationTask( m_scene, m_context, childPath, m_location.children[i] );
+				spawn( *t );
+			}
+			
+			wait_for_all();
+			
+			return 0;
+		}
+
+	private :
+
+		const ScenePlug *m_scene;
+		const Context *m_context;
+		ScenePlug::ScenePath m_scenePath;
+		Location &m_location;
+
+};
+
+void computeLocations( const ScenePlug *scene, const Context *context, Location &root )
+{
+	LocationTask *task = new( tbb::task::allocate_root() ) LocationTask( scene, context, ScenePlug::ScenePath(), root );
+	tbb::task::spawn_root_and_wait( *task );
+}
+
+void writeLocation( const Location &location, const ScenePlug::ScenePath &scenePath, SceneInterface *output, double time )
+{
+	for( CompoundObject::ObjectMap::const_iterator it = location.attributes->members().begin(), eIt = location.attributes->members().end(); it != eIt; it++ )
+	{
+		output->writeAttribute( it->first, it->second.get(), time );
+	}
+	
+	if( scenePath.empty() )
+	{
+		output->writeAttribute( "gaffer:globals", location.globals, time );
+	}
+	
+	if( location.object->typeId() != IECore::NullObjectTypeId && scenePath.size() > 0 )
+	{
+		output->writeObject( location.object, time );
+	}
+	
+	const Imath::Box3f &b = location.bound;
+	output->writeBound( Imath::Box3d( Imath::V3f( b.min ), Imath::V3f( b.max ) ), time );
+	
+	if( scenePath.size() )
+	{
+		const Imath::M44f &t = location.transform;
+		Imath::M44d transform(
+			t[0][0], t[0][1], t[0][2], t[0][3],
+			t[1][0], t[1][1], t[1][2], t[1][3],
+			t[2][0], t[2][1], t[2][2], t[2][3],
+			t[3][0], t[3][1], t[3][2], t[3][3]
+		);
+
+		output->writeTransform( new IECore::M44dData( transform ), time );
+	}
+	
+	const vector<InternedString> &childNames = location.childNames->readable();
+	
+	ScenePlug::ScenePath childScenePath = scenePath;
+	childScenePath.push_back( InternedString() );
+	for( size_t i = 0, e = childNames.size(); i < e; ++i )
+	{
+		childScenePath[scenePath.size()] = childNames[i];
+		
+		SceneInterfacePtr outputChild = output->createChild( childNames[i] );
+		
+		writeLocation( location.children[i], childScenePath, outputChild.get(), time );
+	}
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// SceneWriter
+//////////////////////////////////////////////////////////////////////////
+
 IE_CORE_DEFINERUNTIMETYPED( SceneWriter );
 
 /// \todo hard coded framerate should be replaced with a getTime() method on Gaffer::Context or something
@@ -115,6 +260,12 @@ IECore::MurmurHash SceneWriter::executionHash( const Gaffer::Context *context )
 	return h;
 }
 
+void SceneWriter::executionOutputs( const Gaffer::Context *context, std::vector<std::string> &fileNames ) const
+{
+	Context::Scope scope( context );
+	fileNames.push_back( fileNamePlug()->getValue() );
+}
+
 void SceneWriter::execute( const Contexts &contexts ) const
 {
 	const ScenePlug *scene = inPlug()->getInput<ScenePlug>();
@@ -123,67 +274,31 @@ void SceneWriter::execute( const Contexts &contexts ) const
 		throw IECore::Exception( "No input scene" );
 	}
 	
-	SceneInterfacePtr output = SceneInterface::create( fileNamePlug()->getValue(), IndexedIO::Write );
-	
-	for ( Contexts::const_iterator it = contexts.begin(), eIt = contexts.end(); it != eIt; it++ )
+	if( contexts.empty() )
 	{
-		ContextPtr context = new Context( *it->get(), Context::Borrowed );
-		Context::Scope scopedContext( context );
-		double time = context->getFrame() / g_frameRate;
-		writeLocation( scene, ScenePlug::ScenePath(), context, output.get(), time );
+		return;
 	}
-}
-
-void SceneWriter::writeLocation( const GafferScene::ScenePlug *scene, const ScenePlug::ScenePath &scenePath, Context *context, IECore::SceneInterface *output, double time ) const
-{
-	context->set( ScenePlug::scenePathContextName, scenePath );
 	
-	ConstCompoundObjectPtr attributes = scene->attributesPlug()->getValue();
-	for( CompoundObject::ObjectMap::const_iterator it = attributes->members().begin(), eIt = attributes->members().end(); it != eIt; it++ )
-	{
-		output->writeAttribute( it->first, it->second.get(), time );
-	}
-	
-	if( scenePath.empty() )
-	{
-		ConstCompoundObjectPtr globals = scene->globalsPlug()->getValue();
-		output->writeAttribute( "gaffer:globals", globals, time );
-	}
-	
-	ConstObjectPtr object = scene->objectPlug()->getValue();
-	
-	if( object->typeId() != IECore::NullObjectTypeId && scenePath.size() > 0 )
-	{
-		output->writeObject( object, time );
-	}
+	SceneInterfacePtr output = SceneInterface::create( fileNamePlug()->getValue(), IndexedIO::Write );
 	
-	Imath::Box3f b = scene->boundPlug()->getValue();
+	// The SceneInterface may only be written from a single thread, so we
+	// compute each frame in parallel ahead of writing it, and overlap the
+	// computation of the next frame with the writing of the current one.
 	
-	output->writeBound( Imath::Box3d( Imath::V3f( b.min ), Imath::V3f( b.max ) ), time );
+	Location locations[2];
+	computeLocations( scene, contexts[0].get(), locations[0] );
 	
-	if( scenePath.size() )
+	for( size_t i = 0, e = contexts.size(); i < e; ++i )
 	{
-		Imath::M44f t = scene->transformPlug()->getValue();
-		Imath::M44d transform(
-			t[0][0], t[0][1], t[0][2], t[0][3],
-			t[1][0], t[1][1], t[1][2], t[1][3],
-			t[2][0], t[2][1], t[2][2], t[2][3],
-			t[3][0], t[3][1], t[3][2], t[3][3]
-		);
-
-		output->writeTransform( new IECore::M44dData( transform ), time );
-	}
-	
-	ConstInternedStringVectorDataPtr childNames = scene->childNamesPlug()->getValue();
-	
-	ScenePlug::ScenePath childScenePath = scenePath;
-	childScenePath.push_back( InternedString() );
-	for( vector<InternedString>::const_iterator it=childNames->readable().begin(); it!=childNames->readable().end(); it++ )
-	{
-		childScenePath[scenePath.size()] = *it;
+		tbb::task_group computeNext;
+		if( i + 1 < e )
+		{
+			computeNext.run( boost::bind( &computeLocations, scene, contexts[i+1].get(), boost::ref( locations[(i+1)%2] ) ) );
+		}
 		
-		SceneInterfacePtr outputChild = output->createChild( *it );
+		const double time = contexts[i]->getFrame() / g_frameRate;
+		writeLocation( locations[i%2], ScenePlug::ScenePath(), output.get(), time );
 		
-		writeLocation( scene, childScenePath, context, outputChild, time );
+		computeNext.wait();
 	}
 }
@@ -40,6 +40,7 @@
 #include "boost/tokenizer.hpp"
 
 #include "IECorePython/RunTimeTypedBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
 
 #include "GafferBindings/PlugBinding.h"
 
@@ -83,10 +84,15 @@ void GafferSceneBindings::objectToScenePath(  boost::python::object o, GafferSce
 	throw_error_already_set();
 }
 
+// The accessors below release the GIL while computing, in case the computation
+// needs to reenter Python on another thread, or must wait for another thread
+// which is already computing the same value and needs the GIL to finish.
+
 Imath::Box3f boundWrapper( const ScenePlug &plug, object scenePath )
 {
 	ScenePlug::ScenePath p;
 	objectToScenePath( scenePath, p );
+	IECorePython::ScopedGILRelease gilRelease;
 	return plug.bound( p );
 }
 
@@ -94,6 +100,7 @@ Imath::M44f transformWrapper( const ScenePlug &plug, object scenePath )
 {
 	ScenePlug::ScenePath p;
 	objectToScenePath( scenePath, p );
+	IECorePython::ScopedGILRelease gilRelease;
 	return plug.transform( p );
 }
 
@@ -101,6 +108,7 @@ Imath::M44f fullTransformWrapper( const ScenePlug &plug, object scenePath )
 {
 	ScenePlug::ScenePath p;
 	objectToScenePath( scenePath, p );
+	IECorePython::ScopedGILRelease gilRelease;
 	return plug.fullTransform( p );
 }
 
@@ -108,7 +116,11 @@ static IECore::ObjectPtr objectWrapper( const ScenePlug &plug, object scenePath,
 {
 	ScenePlug::ScenePath p;
 	objectToScenePath( scenePath, p );
-	IECore::ConstObjectPtr o = plug.object( p );
+	IECore::ConstObjectPtr o;
+	{
+		IECorePython::ScopedGILRelease gilRelease;
+		o = plug.object( p );
+	}
 	return copy ? o->copy() : IECore::constPointerCast<IECore::Object>( o );
 }
 
@@ -116,14 +128,23 @@ static IECore::InternedStringVectorDataPtr childNamesWrapper( const ScenePlug &p
 {
 	ScenePlug::ScenePath p;
 	objectToScenePath( scenePath, p );
-	IECore::ConstInternedStringVectorDataPtr n = plug.childNames( p );
+	IECore::ConstInternedStringVectorDataPtr n;
+	{
+		IECorePython::ScopedGILRelease gilRelease;
+		n = plug.childNames( p );
+	}
 	return copy ? n->copy() : IECore::constPointerCast<IECore::InternedStringVectorData>( n );
 }
 
 static IECore::CompoundObjectPtr attributesWrapper( const ScenePlug &plug, object scenePath, bool copy=true )
 {
 	ScenePlug::ScenePath p;
-	objectToScenePath( scenePath, p );IECore::ConstCompoundObjectPtr a = plug.attributes( p );
+	objectToScenePath( scenePath, p );
+	IECore::ConstCompoundObjectPtr a;
+	{
+		IECorePython::ScopedGILRelease gilRelease;
+		a = plug.attributes( p );
+	}
 	return copy ? a->copy() : IECore::constPointerCast<IECore::CompoundObject>( a );
 }
 
@@ -131,6 +152,7 @@ static IECore::CompoundObjectPtr fullAttributesWrapper( const ScenePlug &plug, o
 {
 	ScenePlug::ScenePath p;
 	objectToScenePath( scenePath, p );
+	IECorePython::ScopedGILRelease gilRelease;
 	return plug.fullAttributes( p );
 }
 
@@ -138,6 +160,7 @@ IECore::MurmurHash boundHashWrapper( const ScenePlug &plug, object scenePath )
 {
 	ScenePlug::ScenePath p;
 	objectToScenePath( scenePath, p );
+	IECorePython::ScopedGILRelease gilRelease;
 	return plug.boundHash( p );
 }
 
@@ -145,6 +168,7 @@ IECore::MurmurHash transformHashWrapper( const ScenePlug &plug, object scenePath
 {
 	ScenePlug::ScenePath p;
 	objectToScenePath( scenePath, p );
+	IECorePython::ScopedGILRelease gilRelease;
 	return plug.transformHash( p );
 }
 
@@ -152,6 +176,7 @@ IECore::MurmurHash objectHashWrapper( const ScenePlug &plug, object scenePath )
 {
 	ScenePlug::ScenePath p;
 	objectToScenePath( scenePath, p );
+	IECorePython::ScopedGILRelease gilRelease;
 	return plug.objectHash( p );
 }
 
@@ -159,6 +184,7 @@ IECore::MurmurHash childNamesHashWrapper( const ScenePlug &plug, object scenePat
 {
 	ScenePlug::ScenePath p;
 	objectToScenePath( scenePath, p );
+	IECorePython::ScopedGILRelease gilRelease;
 	return plug.childNamesHash( p );
 }
 
@@ -166,6 +192,7 @@ IECore::MurmurHash attributesHashWrapper( const ScenePlug &plug, object scenePat
 {
 	ScenePlug::ScenePath p;
 	objectToScenePath( scenePath, p );
+	IECorePython::ScopedGILRelease gilRelease;
 	return plug.attributesHash( p );
 } 
 
@@ -65,9 +65,8 @@ class SceneTraversalTask : public tbb::task
 		virtual task *execute()
 		{				
 			
-			ContextPtr context = new Context( *m_context, Context::Borrowed );
-			context->set( ScenePlug::scenePathContextName, m_scenePath );
-			Context::Scope scopedContext( context );
+			Context::EditableScope scope( m_context );
+			scope.set( ScenePlug::scenePathContextName, m_scenePath );
 			
 			m_scenePlug->transformPlug()->getValue();
 			m_scenePlug->boundPlug()->getValue();
@@ -419,7 +419,8 @@ void SceneView::expandSelection( size_t depth )
 	Context::Scope scopedContext( getContext() );
 
 	RenderableGadget::Selection &selection = m_renderableGadget->getSelection();
-	PathMatcher &expanded = expandedPaths()->writable();
+	GafferScene::PathMatcherDataPtr expandedData = expandedPaths()->copy();
+	PathMatcher &expanded = expandedData->writable();
 
 	// must take a copy of the selection to iterate over, because we'll modify the
 	// selection inside expandWalk().
@@ -433,11 +434,10 @@ void SceneView::expandSelection( size_t depth )
 	
 	if( needUpdate )
 	{
-		// we were naughty and modified the expanded paths in place (to avoid
-		// unecessary copying), so the context doesn't know they've changed.
-		// so we emit the changed signal ourselves. this will then trigger update()
-		// via contextChanged().
-		getContext()->changedSignal()( getContext(), "ui:scene:expandedPaths" );
+		// we modified a copy of the expanded paths, because modifying the
+		// context's value in place would leave its hash out of date. setting
+		// the new value will trigger update() via contextChanged().
+		getContext()->set( "ui:scene:expandedPaths", expandedData.get() );
 		// and this will trigger a selection update also via contextChanged().
 		transferSelectionToContext();
 	}
@@ -499,7 +499,7 @@ void SceneView::collapseSelection()
 	
 	set<string> pathsToSelect;
 	vector<const string *> pathsToDeselect;
-	GafferScene::PathMatcherData *expandedData = expandedPaths();
+	GafferScene::PathMatcherDataPtr expandedData = expandedPaths()->copy();
 	PathMatcher &expanded = expandedData->writable();
 	
 	for( RenderableGadget::Selection::const_iterator it = selection.begin(), eIt = selection.end(); it != eIt; it++ )
@@ -531,7 +531,7 @@ void SceneView::collapseSelection()
 	}
 
 	// see comment in expandSelection().
-	getContext()->changedSignal()( getContext(), "ui:scene:expandedPaths" );
+	getContext()->set( "ui:scene:expandedPaths", expandedData.get() );
 	// and this will trigger a selection update also via contextChanged().
 	transferSelectionToContext();
 }
@@ -546,7 +546,7 @@ void SceneView::transferSelectionToContext()
 	getContext()->set( "ui:scene:selectedPaths", s.get() );
 }
 
-GafferScene::PathMatcherData *SceneView::expandedPaths()
+const GafferScene::PathMatcherData *SceneView::expandedPaths()
 {
 	const GafferScene::PathMatcherData *m = getContext()->get<GafferScene::PathMatcherData>( "ui:scene:expandedPaths", 0 );
 	if( !m )
@@ -557,7 +557,7 @@ GafferScene::PathMatcherData *SceneView::expandedPaths()
 		getContext()->set( "ui:scene:expandedPaths", rootOnly.get() );
 		m = getContext()->get<GafferScene::PathMatcherData>( "ui:scene:expandedPaths", 0 );
 	}
-	return const_cast<GafferScene::PathMatcherData *>( m );
+	return m;
 }
 
 void SceneView::baseStateChanged()
@@ -79,3 +79,110 @@ void GafferTest::testManyContexts()
 	// uncomment to get timing information
 	//std::cerr << t.stop() << std::endl;
 }
+
+void GafferTest::testEditableScope()
+{
+	ContextPtr base = new Context();
+	base->set( "a", 1 );
+	base->set( "b", 2 );
+	
+	{
+		Context::EditableScope scope( base.get() );
+		const Context *layer = scope.context();
+		GAFFERTEST_ASSERT( Context::current() == layer );
+		
+		// unmodified layers are equivalent to the original
+		GAFFERTEST_ASSERT( layer->hash() == base->hash() );
+		GAFFERTEST_ASSERT( *layer == *base );
+		
+		// modifications are visible in the layer but not the original
+		scope.set( "b", 20 );
+		scope.set( "c", 30 );
+		GAFFERTEST_ASSERT( layer->get<int>( "a" ) == 1 );
+		GAFFERTEST_ASSERT( layer->get<int>( "b" ) == 20 );
+		GAFFERTEST_ASSERT( layer->get<int>( "c" ) == 30 );
+		GAFFERTEST_ASSERT( base->get<int>( "b" ) == 2 );
+		GAFFERTEST_ASSERT( base->get<int>( "c", -1 ) == -1 );
+		
+		// and the layer hashes and compares identically to a
+		// flat context with the same entries
+		ContextPtr flat = new Context( *base );
+		flat->set( "b", 20 );
+		flat->set( "c", 30 );
+		GAFFERTEST_ASSERT( layer->hash() == flat->hash() );
+		GAFFERTEST_ASSERT( *layer == *flat );
+		GAFFERTEST_ASSERT( *layer != *base );
+		
+		vector<InternedString> names;
+		layer->names( names );
+		GAFFERTEST_ASSERT( names.size() == 4 );
+		
+		// copies of layers are flat and independent
+		ContextPtr copy = new Context( *layer );
+		GAFFERTEST_ASSERT( *copy == *flat );
+		
+		{
+			// layers of layers see all previous modifications
+			Context::EditableScope nestedScope( layer );
+			GAFFERTEST_ASSERT( Context::current() == nestedScope.context() );
+			GAFFERTEST_ASSERT( nestedScope.context()->hash() == flat->hash() );
+			
+			nestedScope.set( "a", 10 );
+			flat->set( "a", 10 );
+			GAFFERTEST_ASSERT( nestedScope.context()->get<int>( "a" ) == 10 );
+			GAFFERTEST_ASSERT( nestedScope.context()->get<int>( "b" ) == 20 );
+			GAFFERTEST_ASSERT( nestedScope.context()->hash() == flat->hash() );
+			GAFFERTEST_ASSERT( layer->get<int>( "a" ) == 1 );
+		}
+		
+		GAFFERTEST_ASSERT( Context::current() == layer );
+		GAFFERTEST_ASSERT( layer->get<int>( "a" ) == 1 );
+	}
+	
+	// recycled layers must not retain the entries of previous scopes
+	{
+		Context::EditableScope scope( base.get() );
+		GAFFERTEST_ASSERT( scope.context()->get<int>( "c", -1 ) == -1 );
+		GAFFERTEST_ASSERT( scope.context()->hash() == base->hash() );
+	}
+}
+
+// A benchmark comparing the per-call overhead of EditableScope
+// against the equivalent creation of a Borrowed Context.
+void GafferTest::testManyEditableScopes()
+{
+	ContextPtr base = new Context();
+	const int numKeys = 20;
+	vector<InternedString> keys;
+	for( int i = 0; i < numKeys; ++i )
+	{
+		InternedString key = string( "testKey" ) + lexical_cast<string>( i );
+		keys.push_back( key );
+		base->set( key, i );
+	}
+	
+	const int numIterations = 100000;
+	
+	Timer borrowedTimer;
+	for( int i = 0; i < numIterations; ++i )
+	{
+		ContextPtr tmp = new Context( *base, Context::Borrowed );
+		tmp->set( keys[i%numKeys], i );
+		Context::Scope scope( tmp.get() );
+		GAFFERTEST_ASSERT( Context::current()->get<int>( keys[i%numKeys] ) == i );
+	}
+	
+	// uncomment to get timing information
+	//std::cerr << "Borrowed Context : " << borrowedTimer.stop() / numIterations * 1e9 << "ns per call" << std::endl;
+	
+	Timer editableScopeTimer;
+	for( int i = 0; i < numIterations; ++i )
+	{
+		Context::EditableScope scope( base.get() );
+		scope.set( keys[i%numKeys], i );
+		GAFFERTEST_ASSERT( Context::current()->get<int>( keys[i%numKeys] ) == i );
+	}
+	
+	// uncomment to get timing information
+	//std::cerr << "EditableScope : " << editableScopeTimer.stop() / numIterations * 1e9 << "ns per call" << std::endl;
+}
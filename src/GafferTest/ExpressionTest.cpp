@@ -0,0 +1,82 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2014, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#include "tbb/tbb.h"
+
+#include "Gaffer/Context.h"
+
+#include "GafferTest/ExpressionTest.h"
+
+using namespace tbb;
+using namespace Gaffer;
+
+namespace
+{
+
+struct GetValue
+{
+
+	GetValue( const IntPlug *plug, const Context *context )
+		:	m_plug( plug ), m_context( context )
+	{
+	}
+
+	void operator()( const blocked_range<int> &r ) const
+	{
+		for( int i=r.begin(); i!=r.end(); ++i )
+		{
+			Context::EditableScope scope( m_context );
+			scope.setFrame( i );
+			m_plug->getValue();
+		}
+	}
+
+	private :
+
+		const IntPlug *m_plug;
+		const Context *m_context;
+
+};
+
+} // namespace
+
+void GafferTest::parallelGetValue( const Gaffer::IntPlug *plug, int numFrames )
+{
+	// the worker threads don't inherit the current context,
+	// so we pass it to them explicitly.
+	GetValue getValue( plug, Context::current() );
+	parallel_for( blocked_range<int>( 0, numFrames ), getValue );
+}
@@ -0,0 +1,90 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2014, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+
+#include "Gaffer/SplinePlug.h"
+
+#include "GafferTest/Assert.h"
+#include "GafferTest/SplineLUTTest.h"
+
+using namespace IECore;
+using namespace Gaffer;
+
+void GafferTest::testSplineLUT()
+{
+	Splineff spline( CubicBasisf::catmullRom() );
+	spline.points.insert( Splineff::PointContainer::value_type( 0, 0 ) );
+	spline.points.insert( Splineff::PointContainer::value_type( 0, 0 ) );
+	spline.points.insert( Splineff::PointContainer::value_type( 0.25, 1 ) );
+	spline.points.insert( Splineff::PointContainer::value_type( 0.75, 0.5 ) );
+	spline.points.insert( Splineff::PointContainer::value_type( 1, 1 ) );
+	spline.points.insert( Splineff::PointContainer::value_type( 1, 1 ) );
+
+	// check the LUT is a good approximation of the spline,
+	// and that it clamps outside the range of the points.
+
+	const SplineffLUT lut( spline );
+	for( float x = -0.5f; x <= 1.5f; x += 0.001f )
+	{
+		GAFFERTEST_ASSERT( fabs( lut( x ) - spline( std::max( 0.0f, std::min( 1.0f, x ) ) ) ) < 0.001f );
+	}
+
+	// check that batch evaluation matches individual evaluation.
+
+	std::vector<float> x, y( 1000 );
+	for( size_t i = 0; i < y.size(); ++i )
+	{
+		x.push_back( float( i ) / ( y.size() - 1 ) );
+	}
+	lut.evaluate( &x[0], &y[0], x.size() );
+	for( size_t i = 0; i < y.size(); ++i )
+	{
+		GAFFERTEST_ASSERT( y[i] == lut( x[i] ) );
+	}
+
+	// check that the plug caches the LUT, and rebuilds it
+	// when the value changes.
+
+	SplineffPlugPtr plug = new SplineffPlug( "spline", Plug::In, spline );
+	SplineffPlug::ConstLUTPtr plugLUT = plug->getLUT();
+	GAFFERTEST_ASSERT( plug->getLUT() == plugLUT );
+	GAFFERTEST_ASSERT( (*plugLUT)( 0.25f ) == lut( 0.25f ) );
+
+	plug->pointYPlug( 1 )->setValue( 2 );
+	GAFFERTEST_ASSERT( plug->getLUT() != plugLUT );
+	GAFFERTEST_ASSERT( fabs( (*plug->getLUT())( 0.25f ) - 2.0f ) < 0.01f );
+}
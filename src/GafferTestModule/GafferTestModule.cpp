@@ -44,6 +44,8 @@
 #include "GafferTest/FilteredRecursiveChildIteratorTest.h"
 #include "GafferTest/MetadataTest.h"
 #include "GafferTest/ContextTest.h"
+#include "GafferTest/ExpressionTest.h"
+#include "GafferTest/SplineLUTTest.h"
 
 using namespace boost::python;
 using namespace GafferTest;
@@ -54,6 +56,12 @@ static void testMetadataThreadingWrapper()
 	testMetadataThreading();
 }
 
+static void parallelGetValueWrapper( const Gaffer::IntPlug *plug, int numFrames )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	parallelGetValue( plug, numFrames );
+}
+
 BOOST_PYTHON_MODULE( _GafferTest )
 {
 	
@@ -63,4 +71,8 @@ BOOST_PYTHON_MODULE( _GafferTest )
 	def( "testFilteredRecursiveChildIterator", &testFilteredRecursiveChildIterator );
 	def( "testMetadataThreading", &testMetadataThreadingWrapper );
 	def( "testManyContexts", &testManyContexts );
+	def( "testEditableScope", &testEditableScope );
+	def( "testManyEditableScopes", &testManyEditableScopes );
+	def( "parallelGetValue", &parallelGetValueWrapper );
+	def( "testSplineLUT", &testSplineLUT );
 }